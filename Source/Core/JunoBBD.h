@@ -2,6 +2,7 @@
 #include <JuceHeader.h>
 #include <vector>
 #include <cmath>
+#include <algorithm>
 
 namespace JunoDSP
 {
@@ -13,38 +14,47 @@ namespace JunoDSP
      * - Compander (NE570 style) integration
      * - Analog Filtering (Anti-aliasing / Reconstruction)
      * - Clock Noise Bleed
+     *
+     * The ring buffer is a power of two, so every wrap is a mask. processBlock()
+     * renders a whole block of modulated delay per line (the chorus path);
+     * processSample() is kept for per-sample callers.
      */
     class JunoBBD
     {
     public:
+        // MN3009 chorus delays stay within ~11-16ms; 20ms leaves room for modulation depth
+        static constexpr float kMaxDelayMs = 20.0f;
+        static constexpr float kMinDelaySamples = 2.0f; // Hermite taps never read unwritten samples
+
         JunoBBD() {}
         
         void prepare(const juce::dsp::ProcessSpec& spec)
         {
             sampleRate = spec.sampleRate;
-            // MN3009 has 256 stages. Max delay ~50ms? 
-            // Juno chorus delay is ~11ms-15ms.
-            // We need a buffer big enough for lowest clock speed.
-            // 20ms at 44.1k = 882 samples.
-            // BBD is often modeled as a fractional delay or a ring buffer.
-            buffer.setSize(1, (int)(sampleRate * 0.1) + 1); // 100ms safety
+            maxBlockSize = juce::jmax(1, (int)spec.maximumBlockSize);
+
+            // [Optimization] Power-of-two ring: max delay + one block + interpolation taps
+            maxDelaySamples = kMaxDelayMs * 0.001f * (float)sampleRate;
+            bufferSize = juce::nextPowerOfTwo((int)std::ceil(maxDelaySamples) + maxBlockSize + 4);
+            bufferMask = bufferSize - 1;
+            buffer.setSize(1, bufferSize);
             buffer.clear();
-            bufferSize = buffer.getNumSamples();
             writePos = 0;
-            readPos = 0.0f;
             
             // Filters
-            lpFilter.prepare(spec);
-            lpFilter.reset(); 
             // MN3009 Reconstruction Filter (approx 10kHz LPF)
+            // [Audit Fix] Coefficients before prepare() so the state is sized here, not on the audio thread
             lpFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, 9000.0f);
+            lpFilter.prepare(spec);
+            lpFilter.reset(); 
         }
         
+        void setRandomSeed(juce::int64 seed) { random.setSeed(seed); } // Seeded renders (see JunoRandom)
+
         void reset() {
             buffer.clear();
             writePos = 0;
-            readPos = 0.0f;
-            currentDelaySamples = 0.0f;
+            lpFilter.reset();
         }
         
         /**
@@ -68,7 +78,7 @@ namespace JunoDSP
             float* outData = ioBuffer.getWritePointer(0);
             
             // Calculate delay in samples
-            float targetDelaySamps = (delayMs * 0.001f) * (float)sampleRate;
+            float targetDelaySamps = juce::jlimit(kMinDelaySamples, maxDelaySamples, (delayMs * 0.001f) * (float)sampleRate);
             
             for (int i = 0; i < numSamples; ++i)
             {
@@ -85,7 +95,7 @@ namespace JunoDSP
                 
                 // Read from BBD
                 // Cubic interpolation for sound quality
-                float actualReadVal = interpolate(targetDelaySamps);
+                float actualReadVal = readTap((float)writePos - targetDelaySamps);
                 
                 // --- 2. CLOCK NOISE & DEGRADATION ---
                 // Add clock whine
@@ -103,44 +113,69 @@ namespace JunoDSP
                 outData[i] = dry * (1.0f - mix) + actualReadVal * mix;
                 
                 // Advance pointers
-                writePos = (writePos + 1) % bufferSize;
+                writePos = (writePos + 1) & bufferMask;
             }
         }
         
-        // Per-sample processing optimized for Chorus loop
+        // Per-sample processing
         float processSample(float input, float delayMs)
         {
-             int bufSize = bufferSize; // Local copy
-             float* buf = buffer.getWritePointer(0);
-             buf[writePos] = input;
-             
-             float delaySamps = (delayMs * 0.001f) * (float)sampleRate;
-             float out = interpolate(delaySamps);
+             buffer.getWritePointer(0)[writePos] = input;
              
-             writePos++;
-             if (writePos >= bufSize) writePos = 0;
+             const float delaySamps = juce::jlimit(kMinDelaySamples, maxDelaySamples, (delayMs * 0.001f) * (float)sampleRate);
+             const float out = readTap((float)writePos - delaySamps);
+             writePos = (writePos + 1) & bufferMask;
              
              // Reconstruction Filter
              return lpFilter.processSample(out);
         }
 
+        /**
+         * Block chorus path: one line, numSamples of modulated delay.
+         * delaySamples[i] is the tap delay (in samples) for input[i]; output may not alias input.
+         */
+        void processBlock(const float* input, const float* delaySamples, float* output, int numSamples)
+        {
+            float* buf = buffer.getWritePointer(0);
+
+            for (int start = 0; start < numSamples; start += maxBlockSize) {
+                const int n = juce::jmin(maxBlockSize, numSamples - start);
+
+                // 1. Write the sub-block into the ring (at most two contiguous runs)
+                const int firstRun = juce::jmin(n, bufferSize - writePos);
+                std::copy(input + start, input + start + firstRun, buf + writePos);
+                std::copy(input + start + firstRun, input + start + n, buf);
+
+                // 2. Modulated taps, each relative to its own write position
+                float* out = output + start;
+                for (int i = 0; i < n; ++i) {
+                    const float d = juce::jlimit(kMinDelaySamples, maxDelaySamples, delaySamples[start + i]);
+                    out[i] = readTap((float)(writePos + i) - d);
+                }
+                writePos = (writePos + n) & bufferMask;
+
+                // 3. Reconstruction Filter over the whole sub-block
+                juce::dsp::AudioBlock<float> block(&out, 1, (size_t)n);
+                lpFilter.process(juce::dsp::ProcessContextReplacing<float>(block));
+            }
+        }
+
     private:
-        float interpolate(float delaySamples)
+        /** Cubic Hermite read at a fractional ring position (may be negative, > -bufferSize). */
+        float readTap(float rPos) const noexcept
         {
-            float rPos = (float)writePos - delaySamples;
-            while (rPos < 0.0f) rPos += (float)bufferSize;
-            while (rPos >= (float)bufferSize) rPos -= (float)bufferSize;
+            rPos += (float)bufferSize; // Positive, so truncation == floor
             
-            int i1 = (int)rPos;
-            int i0 = (i1 - 1 + bufferSize) % bufferSize;
-            int i2 = (i1 + 1) % bufferSize;
-            int i3 = (i1 + 2) % bufferSize;
+            const int i1 = (int)rPos;
+            const float frac = rPos - (float)i1;
+            const int i0 = (i1 - 1) & bufferMask;
+            const int i2 = (i1 + 1) & bufferMask;
+            const int i3 = (i1 + 2) & bufferMask;
             
-            float frac = rPos - (float)i1;
             const float* b = buffer.getReadPointer(0);
             
             // Cubic Hermite Interpolation
-            float y0 = b[i0], y1 = b[i1], y2 = b[i2], y3 = b[i3];
+            float y0 = b[i0], y1 = b[i1 & bufferMask], y2 = b[i2], y3 = b[i3];
             float a0 = -0.5f * y0 + 1.5f * y1 - 1.5f * y2 + 0.5f * y3;
             float a1 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
             float a2 = -0.5f * y0 + 0.5f * y2;
@@ -151,9 +186,10 @@ namespace JunoDSP
 
         juce::AudioBuffer<float> buffer;
         int bufferSize = 0;
+        int bufferMask = 0;
+        int maxBlockSize = 512;
+        float maxDelaySamples = 0.0f;
         int writePos = 0;
-        float readPos = 0.0f;
-        float currentDelaySamples = 0.0f;
         double sampleRate = 44100.0;
         
         juce::dsp::IIR::Filter<float> lpFilter;
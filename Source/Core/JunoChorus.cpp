@@ -0,0 +1,108 @@
+// Source/Core/JunoChorus.cpp
+#include "JunoChorus.h"
+#include "JunoRandom.h"
+
+void JunoChorus::prepare(double sr, int maxBlockSize) {
+    sampleRate = sr;
+    maxBlockSize = juce::jmax(1, maxBlockSize);
+    noiseBuffer.setSize(2, maxBlockSize);
+    wetBuffer.setSize(2, maxBlockSize);
+    delayBuffer.setSize(2, maxBlockSize);
+
+    juce::dsp::ProcessSpec spec { sr, (juce::uint32)maxBlockSize, 2 };
+    lineI.prepare(spec);
+    lineI.reset();
+    lineII.prepare(spec); // [Fidelidad] Second BBD Line
+    lineII.reset();
+
+    preEmphasisFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf(sr, 8000.0f, 0.707f, 1.5f);
+    preEmphasisFilter.prepare(spec); // Mono: runs on the voice bus
+    noiseFilter.prepare(spec);
+    *noiseFilter.state = *juce::dsp::IIR::Coefficients<float>::makeLowPass(sr, 8000.0f, 0.707f);
+}
+
+void JunoChorus::reset() {
+    lineI.reset();
+    lineII.reset();
+}
+
+void JunoChorus::seed(int unit) {
+    lineI.setRandomSeed(JunoRandom::seedFor(JunoRandom::Stream::BBD, 2 * unit));
+    lineII.setRandomSeed(JunoRandom::seedFor(JunoRandom::Stream::BBD, 2 * unit + 1));
+    JunoRandom::seed(noiseGen, JunoRandom::Stream::ChorusNoise, unit + 1); // Index 0 is the thermal drift
+    lfoPhaseI = lfoPhaseII = 0.0f;
+}
+
+void JunoChorus::advance(int numSamples) {
+    auto advancePhase = [numSamples](float& phase, float inc) { phase += inc * (float)numSamples; phase -= std::floor(phase); };
+    advancePhase(lfoPhaseI, JunoChorusConstants::kRateI / (float)sampleRate);
+    advancePhase(lfoPhaseII, JunoChorusConstants::kRateII / (float)sampleRate);
+}
+
+void JunoChorus::process(float* bus, float* outL, float* outR, int numSamples, int mode) {
+    const int maxSlice = wetBuffer.getNumSamples();
+
+    // [Safety] A longer block is rendered in prepared-size slices, never truncated
+    for (int offset = 0; offset < numSamples; offset += maxSlice) {
+        const int n = juce::jmin(maxSlice, numSamples - offset);
+        renderSlice(bus + offset, outL + offset, outR != nullptr ? outR + offset : nullptr, n, mode);
+    }
+}
+
+void JunoChorus::renderSlice(float* bus, float* outL, float* outR, int numSamples, int mode) {
+    const double sr = sampleRate;
+
+    // [VCA/Chorus Audit] Pre-emphasis on the dry bus (de-emphasis runs on the stereo output)
+    juce::dsp::AudioBlock<float> busBlock(&bus, 1, (size_t)numSamples);
+    preEmphasisFilter.process(juce::dsp::ProcessContextReplacing<float>(busBlock));
+
+    float phIncI = JunoChorusConstants::kRateI / (float)sr;
+    float phIncII = JunoChorusConstants::kRateII / (float)sr;
+    
+    // Noise levels: Mode II is slightly noiser (~6dB more? Let's use 0.0004 for I, 0.0008 for II)
+    float noiseLevel = (mode == 2) ? 0.0008f : 0.0004f;
+    if (mode == 3) noiseLevel = 0.0006f; // Mode I+II
+
+    const bool useLineI = (mode == 1 || mode == 3);
+    const bool useLineII = (mode == 2 || mode == 3);
+    const float msToSamples = 0.001f * (float)sr;
+
+    // [Fidelidad] Generate filtered chorus hiss
+    for (int i = 0; i < numSamples; ++i) {
+        noiseBuffer.setSample(0, i, noiseGen.nextFloat() * 2.0f - 1.0f);
+        noiseBuffer.setSample(1, i, noiseGen.nextFloat() * 2.0f - 1.0f);
+    }
+    juce::dsp::AudioBlock<float> noiseBlock = juce::dsp::AudioBlock<float>(noiseBuffer).getSubBlock(0, (size_t)numSamples);
+    juce::dsp::ProcessContextReplacing<float> noiseContext(noiseBlock);
+    noiseFilter.process(noiseContext);
+
+    // [Optimization] Chorus LFOs -> per-sample BBD delays for the chunk (wrap without fmod)
+    float* delayI = delayBuffer.getWritePointer(0);
+    float* delayII = delayBuffer.getWritePointer(1);
+    for (int i = 0; i < numSamples; ++i) {
+        lfoPhaseI += phIncI;
+        if (lfoPhaseI >= 1.0f) lfoPhaseI -= 1.0f;
+        lfoPhaseII += phIncII;
+        if (lfoPhaseII >= 1.0f) lfoPhaseII -= 1.0f;
+        
+        const float lfoI = 2.0f * std::abs(2.0f * (lfoPhaseI - 0.5f)) - 1.0f;
+        const float lfoII = 2.0f * std::abs(2.0f * (lfoPhaseII - 0.5f)) - 1.0f;
+        delayI[i] = (JunoChorusConstants::kDelayI + (lfoI * JunoChorusConstants::kDepthI * 2.0f)) * msToSamples;
+        delayII[i] = (JunoChorusConstants::kDelayII + (lfoII * JunoChorusConstants::kDepthII * 2.0f)) * msToSamples;
+    }
+
+    // One block pass per MN3009 line: line I -> wet L, line II -> wet R
+    float* wetL = wetBuffer.getWritePointer(0);
+    float* wetR = wetBuffer.getWritePointer(1);
+    if (useLineI) lineI.processBlock(bus, delayI, wetL, numSamples);
+    if (useLineII) lineII.processBlock(bus, delayII, wetR, numSamples);
+
+    // Dry/wet matrix: L = dry + wet, R = dry - wet, plus per-side hiss
+    const float* hissL = noiseBuffer.getReadPointer(0);
+    const float* hissR = noiseBuffer.getReadPointer(1);
+    for (int i = 0; i < numSamples; ++i) {
+        const float wetMix = (mode == 3) ? (wetL[i] + wetR[i]) * 0.707f : (useLineI ? wetL[i] : wetR[i]);
+        outL[i] = bus[i] + wetMix + hissL[i] * noiseLevel;
+        if (outR != nullptr) outR[i] = bus[i] - wetMix + hissR[i] * noiseLevel;
+    }
+}
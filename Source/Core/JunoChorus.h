@@ -0,0 +1,55 @@
+// Source/Core/JunoChorus.h
+#pragma once
+
+#include <JuceHeader.h>
+#include "JunoBBD.h"
+#include "SynthParams.h"
+
+/**
+ * JunoChorus - One Juno-106 chorus section: mono voice bus in, stereo out
+ *
+ * Two MN3009 lines (I -> wet L, II -> wet R) clocked by their own triangle
+ * LFOs, pre-emphasis on the dry bus and filtered BBD hiss. De-emphasis is left
+ * to the output stage, which runs once over the host buffer.
+ *
+ * The processor owns the main chorus; in multitimbral mode with per-part
+ * routing every part gets its own (see SimpleJuno106AudioProcessor::setMultitimbral).
+ */
+class JunoChorus {
+public:
+    /** 0 = off, 1 = I, 2 = II, 3 = I + II (both switches). */
+    static int modeFor(const SynthParams& p) { return (p.chorus1 && p.chorus2) ? 3 : (p.chorus1 ? 1 : (p.chorus2 ? 2 : 0)); }
+
+    void prepare(double sampleRate, int maxBlockSize); // Allocates
+    void reset();                                      // Clears the BBD lines (panic)
+    void seed(int unit);                               // [Determinism] Seeded renders: BBD clock noise + hiss, LFOs restart
+
+    /** Renders numSamples (any length; runs longer than the prepared block are sliced) of the given mode. Applies pre-emphasis to bus in place; outR may be null. */
+    void process(float* bus, float* outL, float* outR, int numSamples, int mode);
+
+    /** Idle: the LFOs keep running so resuming lands on the same phase. */
+    void advance(int numSamples);
+
+    float getLfoPhase(int mode) const { return mode == 1 ? lfoPhaseI : lfoPhaseII; }
+
+private:
+    void renderSlice(float* bus, float* outL, float* outR, int numSamples, int mode); // numSamples <= the prepared block
+
+    double sampleRate = 44100.0;
+
+    // [Fidelidad] Authentic MN3009 BBD Emulation
+    JunoDSP::JunoBBD lineI;
+    JunoDSP::JunoBBD lineII; // Mode II / Dual line
+    juce::Random noiseGen;
+
+    // [VCA/Chorus Audit] Filters for authentic chorus emulation
+    juce::dsp::IIR::Filter<float> preEmphasisFilter; // Mono, on the voice bus
+    juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>> noiseFilter;
+    juce::AudioBuffer<float> noiseBuffer;
+    juce::AudioBuffer<float> wetBuffer;
+    juce::AudioBuffer<float> delayBuffer; // Per-sample BBD delays (line I / II)
+
+    // [Fidelidad] Chorus LFOs para Leakage y LED
+    float lfoPhaseI = 0.0f;
+    float lfoPhaseII = 0.0f;
+};
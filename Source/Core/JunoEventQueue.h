@@ -0,0 +1,122 @@
+// Source/Core/JunoEventQueue.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+/**
+ * JunoMpscQueue - Fixed-capacity multi producer / single consumer queue
+ *
+ * Bounded ring of sequenced cells (Vyukov): producers claim a slot with a CAS on
+ * the write index, the consumer releases it by bumping the cell's sequence.
+ * push() and drain() never lock or allocate; a full queue drops the item.
+ */
+template <typename Item, int Capacity>
+class JunoMpscQueue {
+public:
+    static constexpr int kCapacity = Capacity;
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    JunoMpscQueue() noexcept {
+        for (size_t i = 0; i < cells.size(); ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /** Any thread. */
+    bool push(const Item& item) noexcept {
+        size_t pos = writePos.load(std::memory_order_relaxed);
+        for (;;) {
+            auto& cell = cells[pos & kMask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)pos;
+            if (diff == 0) {
+                if (writePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.item = item;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) return false; // Full
+            else pos = writePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    /** Consumer only. Calls handler(const Item&) for every published item, oldest first (at most one lap). */
+    template <typename Handler>
+    void drain(Handler&& handler) {
+        for (int n = 0; n < Capacity; ++n) {
+            auto& cell = cells[readPos & kMask];
+            if (cell.sequence.load(std::memory_order_acquire) != readPos + 1) return; // Empty, or a push still in flight
+            handler(cell.item);
+            cell.sequence.store(readPos + (size_t)Capacity, std::memory_order_release);
+            ++readPos;
+        }
+    }
+
+private:
+    static constexpr size_t kMask = (size_t)Capacity - 1;
+    struct Cell { std::atomic<size_t> sequence { 0 }; Item item {}; };
+
+    std::array<Cell, (size_t)Capacity> cells;
+    std::atomic<size_t> writePos { 0 };
+    size_t readPos = 0; // Consumer only
+};
+
+/**
+ * JunoEventQueue - Lock-free UI -> audio command queue
+ *
+ * Producers: the message thread (on-screen keyboards, panic buttons, preset
+ * loads) and whichever host thread calls setStateInformation; single consumer
+ * (processBlock). The voice manager is owned by the audio thread, so nothing
+ * outside processBlock touches it directly; other threads post here and
+ * processBlock drains the queue before the MIDI buffer.
+ */
+struct JunoEventQueueEvent {
+    enum class Type : juce::uint8 { NoteOn, NoteOff, Panic, ForceUpdate };
+    Type type = Type::NoteOn;
+    juce::uint8 note = 0;
+    float velocity = 0.0f;
+};
+
+class JunoEventQueue : public JunoMpscQueue<JunoEventQueueEvent, 256> {
+public:
+    using Event = JunoEventQueueEvent;
+
+    bool postNoteOn(int note, float velocity) noexcept { return push({ Event::Type::NoteOn, (juce::uint8)juce::jlimit(0, 127, note), velocity }); }
+    bool postNoteOff(int note) noexcept { return push({ Event::Type::NoteOff, (juce::uint8)juce::jlimit(0, 127, note), 0.0f }); }
+    bool postPanic() noexcept { return push({ Event::Type::Panic, 0, 0.0f }); }
+    bool postForceUpdate() noexcept { return push({ Event::Type::ForceUpdate, 0, 0.0f }); }
+};
+
+/**
+ * JunoHeldNotes - Host notes currently held, audio -> UI (display only)
+ *
+ * 128 atomic bits: processBlock sets and clears them from the host MIDI, the
+ * editor polls them on its timer. MidiKeyboardState guards its state with a
+ * CriticalSection, so host notes no longer go through it on the audio thread.
+ */
+class JunoHeldNotes {
+public:
+    /** Audio thread. */
+    void track(const juce::MidiMessage& message) noexcept {
+        if (message.isNoteOn()) set(message.getNoteNumber(), true);
+        else if (message.isNoteOff()) set(message.getNoteNumber(), false);
+        else if (message.isAllNotesOff() || message.isAllSoundOff()) clear();
+    }
+    void clear() noexcept { for (auto& word : words) word.store(0, std::memory_order_relaxed); }
+
+    /** Any thread. */
+    bool isHeld(int note) const noexcept {
+        return ((words[(size_t)((note >> 6) & 1)].load(std::memory_order_relaxed) >> (note & 63)) & 1) != 0;
+    }
+
+private:
+    void set(int note, bool held) noexcept {
+        auto& word = words[(size_t)((note >> 6) & 1)];
+        const juce::uint64 bit = (juce::uint64)1 << (note & 63);
+        if (held) word.fetch_or(bit, std::memory_order_relaxed);
+        else word.fetch_and(~bit, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<juce::uint64>, 2> words {};
+};
@@ -0,0 +1,53 @@
+// Source/Core/JunoRandom.h
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+
+/**
+ * JunoRandom - Global seed for reproducible renders
+ *
+ * Every random source of the engine (DCO spread/drift/sub flip-flop, shared noise bank,
+ * BBD clock noise, chorus hiss, thermal drift, voice bank noise) takes its seed
+ * from here. Unseeded (the default) each source keeps JUCE's own seeding, so no
+ * two instances sound exactly alike - as on the hardware.
+ *
+ * With a global seed set, each source derives a fixed seed from (seed, stream,
+ * index), so the same MIDI and patch render bit-identically. Seeds are applied
+ * in prepare()/prepareToPlay(): set the seed before preparing the processor.
+ */
+namespace JunoRandom
+{
+    enum class Stream : juce::uint32 {
+        DCO = 1,      // JunoDCO::noiseGen, index = voice
+        VoiceNoise,   // Unused since the shared JunoNoiseBank (kept so later streams keep their seeds)
+        VoiceBank,    // JunoVoiceBank drift draws
+        BBD,          // JunoBBD clock noise, index = line
+        ChorusNoise,  // Thermal drift targets (index 0), JunoChorus hiss (index 1 + chorus unit)
+        NoiseBank     // JunoNoiseBank generators (DCO noise + ripple)
+    };
+
+    inline std::atomic<juce::int64>& globalSeed() {
+        static std::atomic<juce::int64> seed { 0 };
+        return seed;
+    }
+
+    /** 0 restores the default (unseeded) behaviour. */
+    inline void setGlobalSeed(juce::int64 seed) { globalSeed().store(seed); }
+    inline juce::int64 getGlobalSeed() { return globalSeed().load(); }
+    inline bool isSeeded() { return getGlobalSeed() != 0; }
+
+    /** Stable per-source seed (SplitMix64 finaliser), never 0. */
+    inline juce::int64 seedFor(Stream stream, int index = 0) {
+        juce::uint64 z = (juce::uint64)getGlobalSeed()
+                       + 0x9E3779B97F4A7C15ull * (((juce::uint64)stream << 16) + (juce::uint64)(index + 1));
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        z ^= (z >> 31);
+        return (juce::int64)(z | 1u);
+    }
+
+    /** Reseeds r for this stream when a global seed is set; otherwise leaves it alone. */
+    inline void seed(juce::Random& r, Stream stream, int index = 0) {
+        if (isSeeded()) r.setSeed(seedFor(stream, index));
+    }
+}
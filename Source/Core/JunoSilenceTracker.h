@@ -0,0 +1,62 @@
+// Source/Core/JunoSilenceTracker.h
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+
+/**
+ * JunoSilenceTracker - Idle detection for the post-voice chain
+ *
+ * Active -> Tail -> Silent
+ * - Active: a voice is sounding, or the voice bus is above the threshold.
+ * - Tail:   voices are done and the bus is quiet; counts down the ring-out of the
+ *           chorus (BBD ~16ms), de-emphasis and DC blocker.
+ * - Silent: the tail has elapsed. processBlock skips LFO, voices, chorus and the
+ *           bus stages and outputs silence (the chorus hiss is gated with it).
+ *
+ * The voice bus is measured before the chorus so its constant hiss never keeps
+ * an idle instance awake. wake() (voice started, parameter edit) returns to
+ * Active before anything is rendered, so no part of a new note is lost.
+ */
+class JunoSilenceTracker {
+public:
+    enum class State { Active, Tail, Silent };
+
+    static constexpr float kThreshold = 1.0e-5f;  // -100 dBFS on the voice bus
+    static constexpr double kTailSeconds = 0.25;  // Longer than every post-voice ring-out
+
+    void prepare(double sampleRate) {
+        tailSamples = juce::jmax(1, (int)(kTailSeconds * sampleRate));
+        wake();
+    }
+
+    void wake() {
+        state = State::Active;
+        tailRemaining = tailSamples;
+        silent.store(false, std::memory_order_relaxed);
+    }
+
+    /** Call once per block after voice rendering. busPeak is only read when no voice is active. */
+    void update(bool voicesActive, float busPeak, int numSamples) {
+        if (voicesActive || busPeak > kThreshold) {
+            wake();
+            return;
+        }
+        if (state == State::Silent) return;
+
+        state = State::Tail;
+        tailRemaining -= numSamples;
+        if (tailRemaining <= 0) {
+            state = State::Silent;
+            silent.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    State getState() const { return state; }
+    bool isSilent() const { return silent.load(std::memory_order_relaxed); } // Safe from any thread
+
+private:
+    State state = State::Active;
+    int tailSamples = 11025;
+    int tailRemaining = 11025;
+    std::atomic<bool> silent { false };
+};
@@ -0,0 +1,203 @@
+// Source/Core/JunoVoiceAllocator.cpp
+#include "JunoVoiceAllocator.h"
+
+//==============================================================================
+void JunoVoiceAllocator::AgeHeap::prepare(int poolSize, const std::vector<juce::uint64>* stamps) {
+    stamp = stamps;
+    heap.assign((size_t)poolSize, -1);
+    slot.assign((size_t)poolSize, -1);
+    count = 0;
+}
+
+void JunoVoiceAllocator::AgeHeap::clear() {
+    for (int k = 0; k < count; ++k) slot[(size_t)heap[(size_t)k]] = -1;
+    count = 0;
+}
+
+void JunoVoiceAllocator::AgeHeap::push(int voice) {
+    if (contains(voice)) return;
+    heap[(size_t)count] = voice;
+    slot[(size_t)voice] = count;
+    siftUp(count++);
+}
+
+void JunoVoiceAllocator::AgeHeap::remove(int voice) {
+    const int k = slot[(size_t)voice];
+    if (k < 0) return;
+    --count;
+    if (k != count) {
+        swapSlots(k, count);
+        siftDown(k);
+        siftUp(k);
+    }
+    slot[(size_t)voice] = -1;
+}
+
+void JunoVoiceAllocator::AgeHeap::swapSlots(int a, int b) {
+    std::swap(heap[(size_t)a], heap[(size_t)b]);
+    slot[(size_t)heap[(size_t)a]] = a;
+    slot[(size_t)heap[(size_t)b]] = b;
+}
+
+void JunoVoiceAllocator::AgeHeap::siftUp(int k) {
+    while (k > 0) {
+        const int parent = (k - 1) / 2;
+        if (!older(k, parent)) break;
+        swapSlots(k, parent);
+        k = parent;
+    }
+}
+
+void JunoVoiceAllocator::AgeHeap::siftDown(int k) {
+    for (;;) {
+        const int left = 2 * k + 1, right = left + 1;
+        int oldest = k;
+        if (left < count && older(left, oldest)) oldest = left;
+        if (right < count && older(right, oldest)) oldest = right;
+        if (oldest == k) break;
+        swapSlots(k, oldest);
+        k = oldest;
+    }
+}
+
+//==============================================================================
+void JunoVoiceAllocator::prepare(int size) {
+    poolSize = juce::jmax(1, size);
+    const size_t words = (size_t)((juce::jmax(poolSize, 6) + 63) / 64);
+    freeByVoice.assign(words, 0);
+    freeByPosition.assign(words, 0);
+    sounding.assign(words, 0);
+    stamp.assign((size_t)poolSize, 0);
+    allByAge.prepare(poolSize, &stamp);
+    releasingByAge.prepare(poolSize, &stamp);
+    voiceKey.assign((size_t)poolSize, -1);
+    gateOn.assign((size_t)poolSize, false);
+    reset(poolSize);
+}
+
+void JunoVoiceAllocator::reset(int limit) {
+    voiceLimit = juce::jlimit(1, poolSize, limit);
+    poly1Range = juce::jmax(voiceLimit, 6);
+    poly1Cursor = 0;
+
+    std::fill(freeByVoice.begin(), freeByVoice.end(), 0);
+    std::fill(freeByPosition.begin(), freeByPosition.end(), 0);
+    std::fill(sounding.begin(), sounding.end(), 0);
+    for (int v = 0; v < voiceLimit; ++v) markFree(v);
+
+    allByAge.clear();
+    releasingByAge.clear();
+    std::fill(voiceKey.begin(), voiceKey.end(), -1);
+    std::fill(gateOn.begin(), gateOn.end(), false);
+    numGateOn = 0;
+    partSounding.fill(0);
+    partGateOn.fill(0);
+    noteVoice.fill(-1);
+    soundingKeys.fill(0);
+}
+
+int JunoVoiceAllocator::findFrom(const Bits& b, int from, int end) noexcept {
+    for (int w = from >> 6; w <= (end - 1) >> 6; ++w) {
+        juce::uint64 bits = b[(size_t)w];
+        if (w == (from >> 6)) bits &= ~(juce::uint64)0 << (from & 63);
+        if (bits == 0) continue;
+        const int i = w * 64 + lowestBit(bits);
+        return i < end ? i : -1;
+    }
+    return -1;
+}
+
+int JunoVoiceAllocator::acquireFree(int polyMode) {
+    if (polyMode == 1) {
+        // Poly 1: cyclic search over the pattern from the cursor, independent of the last allocation
+        int position = findFrom(freeByPosition, poly1Cursor, poly1Range);
+        if (position < 0 && poly1Cursor > 0) position = findFrom(freeByPosition, 0, poly1Cursor);
+        if (position < 0) return -1;
+        poly1Cursor = (position + 1) % poly1Range;
+        return poly1Voice(position);
+    }
+    // Poly 2 / Unison: static allocation, lowest available index
+    return findFrom(freeByVoice, 0, voiceLimit);
+}
+
+int JunoVoiceAllocator::findVoiceToSteal(int polyMode) const {
+    // Poly 2: low-note priority, steal the highest sounding note to preserve the bass
+    if (polyMode == 2) {
+        for (int w = (int)soundingKeys.size() - 1; w >= 0; --w) {
+            const juce::uint64 bits = soundingKeys[(size_t)w];
+            if (bits == 0) continue;
+            const auto high = (juce::uint32)(bits >> 32);
+            const int key = w * 64 + (high != 0 ? 32 + juce::findHighestSetBit(high) : juce::findHighestSetBit((juce::uint32)bits));
+            return noteVoice[(size_t)key];
+        }
+    }
+    // Poly 1 & Unison: oldest releasing voice first, else the oldest sounding one
+    const int releasing = releasingByAge.top();
+    return releasing >= 0 ? releasing : allByAge.top();
+}
+
+void JunoVoiceAllocator::voiceStarted(int voice, int midiNote, int part) {
+    if (isSounding(voice)) {
+        setGate(voice, false); // Retrigger or steal: the voice may change part
+        --partSounding[(size_t)(voiceKey[(size_t)voice] % kMaxParts)];
+        unmapNote(voice);
+        allByAge.remove(voice);
+        releasingByAge.remove(voice);
+    } else {
+        setBit(sounding, voice);
+        clearBit(freeByVoice, voice);
+        clearBit(freeByPosition, poly1Position(voice));
+    }
+
+    const int key = keyFor(midiNote, part);
+    voiceKey[(size_t)voice] = key;
+    ++partSounding[(size_t)(key % kMaxParts)];
+    stamp[(size_t)voice] = ++clock;
+    allByAge.push(voice);
+    setGate(voice, true);
+
+    noteVoice[(size_t)key] = voice;
+    soundingKeys[(size_t)(key >> 6)] |= (juce::uint64)1 << (key & 63);
+}
+
+void JunoVoiceAllocator::voiceReleased(int voice) {
+    if (!isSounding(voice) || !gateOn[(size_t)voice]) return;
+    setGate(voice, false);
+    releasingByAge.push(voice);
+}
+
+void JunoVoiceAllocator::allReleased() {
+    forEachSounding([this](int v) { voiceReleased(v); });
+}
+
+void JunoVoiceAllocator::voiceFinished(int voice) {
+    if (!isSounding(voice)) return;
+    setGate(voice, false);
+    --partSounding[(size_t)(voiceKey[(size_t)voice] % kMaxParts)];
+    unmapNote(voice);
+    allByAge.remove(voice);
+    releasingByAge.remove(voice);
+    clearBit(sounding, voice);
+    if (voice < voiceLimit) markFree(voice);
+}
+
+void JunoVoiceAllocator::setGate(int voice, bool on) {
+    if (gateOn[(size_t)voice] == on) return;
+    gateOn[(size_t)voice] = on;
+    const int delta = on ? 1 : -1;
+    numGateOn += delta;
+    partGateOn[(size_t)(voiceKey[(size_t)voice] % kMaxParts)] += delta;
+}
+
+void JunoVoiceAllocator::markFree(int voice) {
+    setBit(freeByVoice, voice);
+    setBit(freeByPosition, poly1Position(voice));
+}
+
+void JunoVoiceAllocator::unmapNote(int voice) {
+    const int key = voiceKey[(size_t)voice];
+    voiceKey[(size_t)voice] = -1;
+    if (key < 0 || noteVoice[(size_t)key] != voice) return; // Unison: another voice owns the mapping
+    noteVoice[(size_t)key] = -1;
+    soundingKeys[(size_t)(key >> 6)] &= ~((juce::uint64)1 << (key & 63));
+}
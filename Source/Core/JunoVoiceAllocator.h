@@ -0,0 +1,117 @@
+// Source/Core/JunoVoiceAllocator.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+/**
+ * JunoVoiceAllocator - Voice bookkeeping for JunoVoiceManager
+ *
+ * Keeps note-on cost flat as the pool grows (the manager used to scan every voice):
+ * - Free voices: bitsets, by voice index (Poly 2 / Unison: lowest free) and by
+ *   Poly 1 pattern position (cyclic {0, 2, 4, 1, 3, 5, 6, 7, ...} search).
+ * - Age: indexed min-heaps on the note-on stamp, one for every sounding voice and
+ *   one for releasing voices: "oldest releasing, else oldest" is O(log n).
+ * - Notes: (note, part) -> voice map for retrigger / note-off, and a set of sounding
+ *   keys for Poly 2's "steal the highest note". Keys are note * kMaxParts + part, so
+ *   the highest key is the highest note whatever part plays it.
+ * - Sounding / gate-on counters, in total and per multitimbral part.
+ *
+ * Pure bookkeeping: the manager reports starts and releases, and voices that went
+ * idle on their own after each render. prepare() allocates; everything else is
+ * realtime-safe.
+ */
+class JunoVoiceAllocator {
+public:
+    static constexpr int kMaxParts = 16; // One per MIDI channel
+
+    void prepare(int poolSize);
+    void reset(int voiceLimit); // Every voice below the limit free, nothing sounding
+
+    /** Next free voice for the poly mode (-1 if none). Poly 1 advances its cyclic cursor. */
+    int acquireFree(int polyMode);
+    int findVoiceToSteal(int polyMode) const;
+    int voiceForNote(int midiNote, int part = 0) const { return noteVoice[(size_t)keyFor(midiNote, part)]; }
+
+    void voiceStarted(int voice, int midiNote, int part = 0);
+    void voiceReleased(int voice);
+    void voiceFinished(int voice);
+    void allReleased();
+
+    bool isSounding(int voice) const { return testBit(sounding, voice); }
+    bool isGateOn(int voice) const { return gateOn[(size_t)voice]; }
+    bool anyGateOn() const { return numGateOn > 0; }
+    bool anyGateOn(int part) const { return partGateOn[(size_t)part] > 0; }
+    int getNumSounding() const { return allByAge.size(); }
+    int getNumReleasing() const { return releasingByAge.size(); }
+    int getNumSounding(int part) const { return partSounding[(size_t)part]; }
+
+    /** Calls fn(voice) for every sounding voice, in ascending index order. */
+    template <typename Fn>
+    void forEachSounding(Fn&& fn) const {
+        for (size_t w = 0; w < sounding.size(); ++w) {
+            for (juce::uint64 bits = sounding[w]; bits != 0; bits &= bits - 1)
+                fn((int)(w * 64) + lowestBit(bits));
+        }
+    }
+
+private:
+    using Bits = std::vector<juce::uint64>;
+    static constexpr int kNumKeys = 128 * kMaxParts;
+
+    static int keyFor(int midiNote, int part) noexcept { return (midiNote & 127) * kMaxParts + (part & (kMaxParts - 1)); }
+
+    /** Min-heap of voice indices keyed by stamp[], with O(1) lookup of a voice's slot. */
+    class AgeHeap {
+    public:
+        void prepare(int poolSize, const std::vector<juce::uint64>* stamps);
+        void clear();
+        bool contains(int voice) const { return slot[(size_t)voice] >= 0; }
+        int top() const { return count > 0 ? heap[0] : -1; }
+        int size() const { return count; }
+        void push(int voice);
+        void remove(int voice);
+
+    private:
+        bool older(int a, int b) const { return (*stamp)[(size_t)heap[(size_t)a]] < (*stamp)[(size_t)heap[(size_t)b]]; }
+        void swapSlots(int a, int b);
+        void siftUp(int k);
+        void siftDown(int k);
+
+        std::vector<int> heap, slot;
+        const std::vector<juce::uint64>* stamp = nullptr;
+        int count = 0;
+    };
+
+    static int lowestBit(juce::uint64 w) noexcept { return juce::countNumberOfBits((w & (~w + 1)) - 1); }
+    static bool testBit(const Bits& b, int i) noexcept { return ((b[(size_t)(i >> 6)] >> (i & 63)) & 1) != 0; }
+    static void setBit(Bits& b, int i) noexcept { b[(size_t)(i >> 6)] |= (juce::uint64)1 << (i & 63); }
+    static void clearBit(Bits& b, int i) noexcept { b[(size_t)(i >> 6)] &= ~((juce::uint64)1 << (i & 63)); }
+    static int findFrom(const Bits& b, int from, int end) noexcept; // First set bit in [from, end), or -1
+
+    // [Fidelidad] Hardware 8253 pattern {0, 2, 4, 1, 3, 5}; voices past the sixth follow in order
+    static int poly1Voice(int position) noexcept { static constexpr int order[6] = { 0, 2, 4, 1, 3, 5 }; return position < 6 ? order[position] : position; }
+    static int poly1Position(int voice) noexcept { static constexpr int position[6] = { 0, 3, 1, 4, 2, 5 }; return voice < 6 ? position[voice] : voice; }
+
+    void markFree(int voice);
+    void unmapNote(int voice);
+    void setGate(int voice, bool on);
+
+    int poolSize = 0;
+    int voiceLimit = 0;
+    int poly1Range = 0;     // Pattern positions in play: max(limit, 6)
+    int poly1Cursor = 0;    // [Fidelidad] Authentic cyclic allocation state
+
+    Bits freeByVoice, freeByPosition, sounding;
+    std::vector<juce::uint64> stamp;
+    juce::uint64 clock = 0;
+    AgeHeap allByAge, releasingByAge;
+
+    std::vector<int> voiceKey;
+    std::vector<bool> gateOn;
+    int numGateOn = 0;
+    std::array<int, kMaxParts> partSounding {}, partGateOn {};
+    std::array<int, kNumKeys> noteVoice {};
+    std::array<juce::uint64, kNumKeys / 64> soundingKeys {};
+};
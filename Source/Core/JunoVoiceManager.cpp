@@ -1,217 +1,437 @@
 #include "JunoVoiceManager.h"
 
-JunoVoiceManager::JunoVoiceManager() {
-    for (auto& ts : voiceTimestamps) ts.store(0);
+JunoVoiceManager::JunoVoiceManager(int numVoices) {
+    setPoolSize(numVoices);
 }
 
-void JunoVoiceManager::prepare(double sampleRate, int maxBlockSize) {
-    for (int i = 0; i < MAX_VOICES; ++i) {
+void JunoVoiceManager::setPoolSize(int numVoices) {
+    numVoices = juce::jlimit(1, kMaxPoolSize, numVoices);
+    if (numVoices == poolSize) return;
+
+    poolSize = numVoices;
+    voices = std::vector<Voice>((size_t)poolSize);
+    renderList.assign((size_t)poolSize, 0);
+    neighborLevel.assign((size_t)poolSize, 0.0f);
+    voicePart.assign((size_t)poolSize, 0);
+    shedCandidates.assign((size_t)poolSize, 0);
+    allocator.prepare(poolSize);
+    currentActiveVoices = poolSize; // [Fix] The whole pool plays; setVoiceLimit narrows it
+    allocator.reset(currentActiveVoices);
+    setAllowedVoices(currentActiveVoices);
+}
+
+void JunoVoiceManager::setNumParts(int newNumParts) {
+    newNumParts = juce::jlimit(1, kMaxParts, newNumParts);
+    if (newNumParts == numParts) return;
+
+    resetAllVoices();
+    numParts = newNumParts;
+    for (int p = 1; p < kMaxParts; ++p) partParams[(size_t)p] = partParams[0];
+    std::fill(voicePart.begin(), voicePart.end(), 0);
+    // [Fidelidad] The SIMD bank plays one patch on every lane: parts need per-voice parameters
+    useVoiceBank.store(numParts == 1 && voiceBankRequested);
+}
+
+int JunoVoiceManager::partForChannel(int midiChannel) const {
+    if (numParts == 1) return 0;
+    return (midiChannel >= 1 && midiChannel <= numParts) ? midiChannel - 1 : -1;
+}
+
+void JunoVoiceManager::prepare(double newSampleRate, int maxBlockSize) {
+    sampleRate = newSampleRate;
+    hpfCoefficients.prepare(sampleRate);
+    envelopeRates.prepare(sampleRate); // Also builds the shared JunoCurveTables off the audio thread
+    voiceBank.setCoefficientCache(&hpfCoefficients);
+    voiceBank.setEnvelopeRates(&envelopeRates);
+    noiseBank.prepare(sampleRate, maxBlockSize, poolSize);
+    voiceBank.setNoiseBank(&noiseBank);
+
+    for (int i = 0; i < poolSize; ++i) {
+        voices[i].setCoefficientCache(&hpfCoefficients);
+        voices[i].setEnvelopeRates(&envelopeRates);
+        voices[i].setNoiseBank(&noiseBank);
+        voices[i].setVoiceIndex(i); // [Fidelidad] Assign physical index for Unison Detune (and seed stream)
         voices[i].prepare(sampleRate, maxBlockSize);
-        voices[i].setVoiceIndex(i); // [Fidelidad] Assign physical index for Unison Detune
     }
+    voiceBank.prepare(sampleRate, maxBlockSize);
+    allocator.reset(currentActiveVoices); // prepare() silenced every voice
+
+    for (auto& b : slotBus) b.assign((size_t)juce::jmax(1, maxBlockSize), 0.0f);
+    scratchStride = juce::jmax(1, maxBlockSize);
+    voiceScratch.assign((size_t)(poolSize * scratchStride), 0.0f);
+    if (parallelRendering && !useVoiceBank.load()) workerPool->start(); // The SIMD bank renders on the caller only
+
+    governorWindow = juce::jmax(1, juce::roundToInt(sampleRate * kGovernorWindowMs * 0.001));
+    shedFadeSamples = juce::jmax(1, juce::roundToInt(sampleRate * kShedFadeMs * 0.001));
+    windowTicks = 0;
+    windowSamples = 0;
+    overBudgetStreak = 0;
+    setAllowedVoices(currentActiveVoices);
 }
 
-void JunoVoiceManager::updateParams(const SynthParams& params) {
-    for (auto& voice : voices) {
-        voice.updateParams(params);
+void JunoVoiceManager::setRenderEngine(RenderEngine engine) {
+    voiceBankRequested = (engine == RenderEngine::VoiceBank);
+    const bool bank = voiceBankRequested && numParts == 1;
+    if (useVoiceBank.load() == bank) return;
+
+    resetAllVoices(); // Voices don't migrate between engines
+    useVoiceBank.store(bank);
+}
+
+template <typename Fn>
+void JunoVoiceManager::forEachVoiceOf(int part, Fn&& fn) {
+    if (part == kAllParts) {
+        for (auto& voice : voices) fn(voice);
+        return;
     }
+    for (int i = 0; i < poolSize; ++i)
+        if (voicePart[(size_t)i] == part) fn(voices[(size_t)i]);
+}
+
+void JunoVoiceManager::updateParams(const SynthParams& params, juce::uint32 dirty, int part) {
+    if (part == kAllParts) std::fill(partParams.begin(), partParams.begin() + numParts, params);
+    else partParams[(size_t)part] = params;
+    if (dirty & SynthParamDirty::Dco) updateNoiseEnabled();
+
+    // Both engines are kept in sync so switching never plays a stale patch
+    forEachVoiceOf(part, [&](Voice& voice) { voice.updateParams(params, dirty); });
+    if (part == kAllParts || numParts == 1) voiceBank.updateParams(params, dirty);
+}
+
+void JunoVoiceManager::updateNoiseEnabled() {
+    noiseEnabled = false;
+    for (int p = 0; p < numParts; ++p) noiseEnabled = noiseEnabled || partParams[(size_t)p].noiseLevel > 0.0f;
+}
+
+void JunoVoiceManager::setThermalDrift(float drift) {
+    // [Audit Fix] Power curve for better resolution in low values, evaluated once for every voice
+    thermalDrift = drift;
+    curvedThermalDrift = JunoCurveTables::thermalDrift(drift);
+    voiceBank.setThermalDrift(drift, curvedThermalDrift); // One shared value for the whole bank
+    // [Optimization] Only sounding voice objects follow it; idle ones pick it up in startVoice
+    if (!useVoiceBank.load()) allocator.forEachSounding([this](int i) { voices[(size_t)i].setThermalDrift(thermalDrift, curvedThermalDrift); });
+    for (auto& p : partParams) p.thermalDrift = drift;
 }
 
 void JunoVoiceManager::forceUpdate() {
     for (auto& voice : voices) {
         voice.forceUpdate();
     }
+    voiceBank.forceUpdate();
+}
+
+void JunoVoiceManager::startVoice(int i, int note, float velocity, bool isLegato, int part) {
+    if (voicePart[(size_t)i] != part) {
+        // Multitimbral: the voice changes patch, snapped like a patch load
+        voicePart[(size_t)i] = part;
+        voices[i].updateParams(partParams[(size_t)part]);
+        voices[i].forceUpdate();
+    }
+    if (useVoiceBank.load()) {
+        voiceBank.noteOn(i, note, velocity, isLegato);
+    } else {
+        voices[i].setThermalDrift(thermalDrift, curvedThermalDrift); // Idle voices miss the drift pushes
+        voices[i].noteOn(note, velocity, isLegato);
+    }
+    allocator.voiceStarted(i, note, part);
+    lastAllocatedVoiceIndex.store(i);
+}
+
+void JunoVoiceManager::releaseVoice(int i) {
+    if (useVoiceBank.load()) voiceBank.noteOff(i);
+    else voices[i].noteOff();
+    allocator.voiceReleased(i);
+}
+
+void JunoVoiceManager::reclaimFinishedVoices() {
+    allocator.forEachSounding([this](int i) {
+        if (!isVoiceActive(i)) allocator.voiceFinished(i); // Clears only the bit being visited
+    });
 }
 
-void JunoVoiceManager::renderNextBlock(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, const std::vector<float>& lfoBuffer) {
+void JunoVoiceManager::renderNextBlock(float* bus, int numSamples, const std::vector<float>& lfoBuffer) {
     static bool firstRender = true;
-    if (firstRender) { DBG("JunoVoiceManager::renderNextBlock FIRST CALL"); firstRender = false; }
+    if (firstRender) { JUNO_RT_EXEMPT DBG("JunoVoiceManager::renderNextBlock FIRST CALL"); firstRender = false; }
     
-    const juce::ScopedLock sl(lock);
-    for (int i = 0; i < currentActiveVoices; ++i) {
-        if (voices[i].isActive()) {
-            float neighborOut = voices[(i + 1) % currentActiveVoices].lastActiveOutputLevel(); 
-            voices[i].renderNextBlock(buffer, startSample, numSamples, lfoBuffer, neighborOut);
-        }
+    const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+
+    // [Fidelidad] One noise generator for the whole synth, rendered once ahead of the voices
+    noiseBank.renderBlock(numSamples, noiseEnabled);
+
+    if (useVoiceBank.load()) {
+        voiceBank.renderNextBlock(bus, numSamples, lfoBuffer, currentActiveVoices);
+        reclaimFinishedVoices();
+    } else {
+        // Single-timbral: every voice is part 0
+        const std::vector<float>* lfo = &lfoBuffer;
+        renderVoiceObjects(&bus, &lfo, numSamples);
     }
+    cullInaudibleTails();
+
+    governLoad(juce::Time::getHighResolutionTicks() - startTicks, numSamples);
 }
 
-void JunoVoiceManager::setPolyMode(int mode) {
-    if (polyMode != mode) {
-        polyMode = mode;
-        resetAllVoices(); // [Fidelidad] Limpiar todo al cambiar modo
-    }
+void JunoVoiceManager::renderParts(float* const* partBuses, const std::vector<float>* const* partLfos, int numSamples) {
+    jassert(!useVoiceBank.load() || numParts == 1);
+    const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+    noiseBank.renderBlock(numSamples, noiseEnabled); // Shared by every part, as the voices are
+    renderVoiceObjects(partBuses, partLfos, numSamples);
+    cullInaudibleTails();
+    governLoad(juce::Time::getHighResolutionTicks() - startTicks, numSamples);
 }
 
-void JunoVoiceManager::noteOn(int /*midiChannel*/, int midiNote, float velocity) {
-    const juce::ScopedLock sl(lock);
-    currentTimestamp++;
-    
-    // UNISON (Mode 3): Trigger all voices within the limit
-    if (polyMode == 3) {
-        bool isLegatoTransition = isAnyNoteHeld();
-        for (int i = 0; i < currentActiveVoices; ++i) {
-            voices[i].noteOn(midiNote, velocity, isLegatoTransition);
-            voiceTimestamps[i].store(currentTimestamp.load());
-        }
-        lastAllocatedVoiceIndex.store(0);
+void JunoVoiceManager::governLoad(juce::int64 renderTicks, int numSamples) {
+    const float budget = cpuBudget.load(std::memory_order_relaxed);
+    if (!governorEnabled || budget <= 0.0f) {
+        if (allowedVoices != currentActiveVoices) setAllowedVoices(currentActiveVoices);
+        windowTicks = 0;
+        windowSamples = 0;
         return;
     }
 
-    // POLY (Mode 1 & 2): Allocation logic for single voice
-    // 1. Buscar si la nota ya está sonando para hacer Retrigger
-    for (int i = 0; i < currentActiveVoices; ++i) {
-        if (voices[i].isActive() && voices[i].getCurrentNote() == midiNote) {
-            voices[i].noteOn(midiNote, velocity, false); 
-            voiceTimestamps[i].store(currentTimestamp.load());
-            lastAllocatedVoiceIndex.store(i);
-            return;
-        }
-    }
+    // Render time is judged over a window: one chunk is too short to mean anything
+    windowTicks += renderTicks;
+    windowSamples += numSamples;
+    if (windowSamples < governorWindow) return;
 
-    // 2. Buscar una voz libre
-    int voiceIndex = findFreeVoiceIndex();
+    const float load = (float)(juce::Time::highResolutionTicksToSeconds(windowTicks) * sampleRate / (double)windowSamples);
+    windowTicks = 0;
+    windowSamples = 0;
+    publishedLoad.store(load, std::memory_order_relaxed);
 
-    // 3. Si no hay libres, robar la más antigua
-    if (voiceIndex == -1) {
-        voiceIndex = findVoiceToSteal();
+    if (load <= budget) {
+        overBudgetStreak = 0;
+        if (load < budget * kRecoverShare && allowedVoices < currentActiveVoices) setAllowedVoices(allowedVoices + 1);
+        return;
     }
-    
-    if (voiceIndex != -1) {
-        voices[voiceIndex].noteOn(midiNote, velocity, false);
-        voiceTimestamps[voiceIndex].store(currentTimestamp.load());
-        lastAllocatedVoiceIndex.store(voiceIndex);
+
+    overBudgetWindows.fetch_add(1, std::memory_order_relaxed);
+    if (++overBudgetStreak < kOverBudgetWindowsToShed) return;
+    overBudgetStreak = 0;
+
+    // Render cost follows the voice count: keep the share of voices that fits the budget
+    const int sounding = allocator.getNumSounding();
+    if (sounding == 0) return; // Nothing to shed: the load is not the voices'
+    const int fits = juce::jmax(1, (int)((float)sounding * budget / load));
+    const int shed = shedQuietestVoices(sounding - fits);
+    const int cap = juce::jlimit(1, currentActiveVoices, juce::jmin(allowedVoices, fits));
+    if (shed > 0 || cap < allowedVoices) {
+        shedEvents.fetch_add(1, std::memory_order_relaxed);
+        voicesShed.fetch_add((juce::uint32)shed, std::memory_order_relaxed);
     }
+    setAllowedVoices(cap);
 }
 
-void JunoVoiceManager::noteOff(int /*midiChannel*/, int midiNote, float /*velocity*/) {
-    const juce::ScopedLock sl(lock);
-    if (polyMode == 3) { // UNISON
-        for (int i = 0; i < currentActiveVoices; ++i) {
-             if (voices[i].getCurrentNote() == midiNote) voices[i].noteOff();
-        }
-        return;
-    }
+int JunoVoiceManager::shedQuietestVoices(int count) {
+    if (count <= 0) return 0;
 
-    for (int i = 0; i < currentActiveVoices; ++i) {
-        if (voices[i].isActive() && voices[i].getCurrentNote() == midiNote) {
-            voices[i].noteOff();
-            return;
-        }
+    int numCandidates = 0;
+    allocator.forEachSounding([&](int i) {
+        if (!isVoiceShedding(i)) shedCandidates[(size_t)numCandidates++] = i;
+    });
+    count = juce::jmin(count, numCandidates);
+    if (count == 0) return 0;
+
+    // Releasing voices (gate off) go first, quietest first within each group
+    const auto begin = shedCandidates.begin();
+    std::partial_sort(begin, begin + count, begin + numCandidates, [this](int a, int b) {
+        const bool releasingA = !allocator.isGateOn(a), releasingB = !allocator.isGateOn(b);
+        if (releasingA != releasingB) return releasingA;
+        return getVoiceLevel(a) < getVoiceLevel(b);
+    });
+
+    for (int k = 0; k < count; ++k) shedVoice(shedCandidates[(size_t)k]);
+    return count;
+}
+
+void JunoVoiceManager::shedVoice(int i) {
+    if (useVoiceBank.load()) voiceBank.shed(i, shedFadeSamples);
+    else voices[(size_t)i].shed(shedFadeSamples);
+    allocator.voiceReleased(i); // Fading: first in line for a steal
+}
+
+void JunoVoiceManager::cullInaudibleTails() {
+    if (allocator.getNumReleasing() == 0) return;
+
+    const float floorDb = tailFloorDb.load(std::memory_order_relaxed);
+    if (floorDb != cachedFloorDb) {
+        cachedFloorDb = floorDb;
+        tailFloorGain = juce::Decibels::decibelsToGain(floorDb, -200.0f);
     }
+    if (tailFloorGain <= 0.0f) return;
+
+    // The floor sits at the output: a quieter master level lets tails go earlier
+    const float floorLevel = tailFloorGain / juce::jmax(1.0e-6f, masterGain);
+    int culled = 0;
+    allocator.forEachSounding([&](int i) {
+        if (allocator.isGateOn(i)) return;
+        const float predicted = useVoiceBank.load() ? voiceBank.predictTailLevel(i) : voices[(size_t)i].predictTailLevel();
+        if (predicted * kTailHeadroom >= floorLevel) return;
+        shedVoice(i);
+        ++culled;
+    });
+    if (culled > 0) tailsCulled.fetch_add((juce::uint32)culled, std::memory_order_relaxed);
+}
+
+void JunoVoiceManager::setAllowedVoices(int numVoices) {
+    allowedVoices = juce::jlimit(1, juce::jmax(1, currentActiveVoices), numVoices);
+    publishedAllowed.store(allowedVoices, std::memory_order_relaxed);
+    publishedShedding.store(allowedVoices < currentActiveVoices, std::memory_order_relaxed);
 }
 
-// [Fidelidad] Static counter REMOVED in favor of instance member 'nextPoly1Index'
+JunoVoiceManager::LoadGovernorState JunoVoiceManager::getLoadGovernorState() const {
+    LoadGovernorState state;
+    state.allowedVoices = publishedAllowed.load(std::memory_order_relaxed);
+    state.shedding = publishedShedding.load(std::memory_order_relaxed);
+    state.load = publishedLoad.load(std::memory_order_relaxed);
+    state.overBudgetWindows = overBudgetWindows.load(std::memory_order_relaxed);
+    state.shedEvents = shedEvents.load(std::memory_order_relaxed);
+    state.voicesShed = voicesShed.load(std::memory_order_relaxed);
+    return state;
+}
 
-int JunoVoiceManager::findFreeVoiceIndex() {
-    // Poly 1: Round Robin (Cyclic Fixed Pattern)
-    // [Fidelidad] Hardware 8253 Pattern: {0, 2, 4, 1, 3, 5}
-    static const int voiceOrder[MAX_VOICES] = {0, 2, 4, 1, 3, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+void JunoVoiceManager::renderVoiceObjects(float* const* buses, const std::vector<float>* const* lfos, int numSamples) {
+    // Neighbour levels are snapshotted first, so crosstalk always comes from the previous
+    // block (as in JunoVoiceBank) whatever order or thread renders the voices
+    int numToRender = 0;
+    allocator.forEachSounding([&](int i) {
+        neighborLevel[(size_t)i] = voices[(size_t)((i + 1) % currentActiveVoices)].lastActiveOutputLevel();
+        renderList[(size_t)numToRender++] = i;
+    });
 
-    if (polyMode == 1) {
-        // [Audit Fix] Cyclic search pattern independent of last allocation
-        int startIndex = nextPoly1Index;
-        for (int i = 0; i < currentActiveVoices; ++i) {
-            int currentPatternIdx = (startIndex + i) % currentActiveVoices;
-            int voiceIdx = voiceOrder[currentPatternIdx];
-            
-            if (!voices[voiceIdx].isActive()) {
-                nextPoly1Index = (currentPatternIdx + 1) % currentActiveVoices; 
-                return voiceIdx;
-            }
+    if (!parallelRendering || numToRender < 2) {
+        for (int k = 0; k < numToRender; ++k) {
+            const int i = renderList[(size_t)k];
+            const int part = voicePart[(size_t)i];
+            voices[i].renderNextBlock(buses[part], numSamples, *lfos[part], neighborLevel[(size_t)i]);
         }
+        reclaimFinishedVoices();
+        return;
     }
-    // Poly 2: Static Allocation (Lowest Available Index)
-    else if (polyMode == 2 || polyMode == 3) {
-         for (int i = 0; i < currentActiveVoices; ++i) {
-            if (!voices[i].isActive()) return i;
+
+    // [Optimization] One task per voice on the shared pool; every slot is cleared and summed
+    // because another instance may start the pool's workers at any time
+    numSamples = juce::jmin(numSamples, (int)slotBus[0].size());
+    renderBuses = buses;
+    renderLfos = lfos;
+    renderSamples = numSamples;
+    if (numParts == 1) {
+        for (auto& b : slotBus) juce::FloatVectorOperations::clear(b.data(), numSamples);
+        workerPool->run(&JunoVoiceManager::renderVoiceTask, this, numToRender);
+        for (auto& b : slotBus) juce::FloatVectorOperations::add(buses[0], b.data(), numSamples);
+    } else {
+        // Multitimbral: each voice renders alone, then lands on its part's bus
+        workerPool->run(&JunoVoiceManager::renderVoiceTask, this, numToRender);
+        for (int k = 0; k < numToRender; ++k) {
+            const int i = renderList[(size_t)k];
+            juce::FloatVectorOperations::add(buses[voicePart[(size_t)i]], voiceScratch.data() + i * scratchStride, numSamples);
         }
     }
-    // Fallback or Mono modes (handled by Poly 2 logic effectively for allocation)
-    return -1;
-}
-
-int JunoVoiceManager::findVoiceToSteal() {
-    // Poly 2: Low Note Priority (Steal Highest Note to preserve Bass)
-    // Actually "Last Note Priority" usually means steal the oldest? 
-    // But Audit Req: "Low-Note Priority (Steal Highest)". 
-    if (polyMode == 2) {
-        int highestNote = -1;
-        int stealIdx = -1;
-        
-        // Find highest note to kill (preserve bass)
-        for (int i=0; i < currentActiveVoices; ++i) {
-             // Only considering active voices
-             if (voices[i].isActive()) {
-                 int note = voices[i].getCurrentNote();
-                 // If notes are equal, fallback to age?
-                 if (note > highestNote) {
-                     highestNote = note;
-                     stealIdx = i;
-                 }
-             }
-        }
-        if (stealIdx != -1) return stealIdx;
+    reclaimFinishedVoices();
+}
+
+void JunoVoiceManager::renderVoiceTask(void* context, int taskIndex, int slot) {
+    auto& vm = *static_cast<JunoVoiceManager*>(context);
+    const int i = vm.renderList[(size_t)taskIndex];
+    const int part = vm.voicePart[(size_t)i];
+    float* out = vm.slotBus[(size_t)slot].data();
+    if (vm.numParts > 1) {
+        out = vm.voiceScratch.data() + i * vm.scratchStride;
+        juce::FloatVectorOperations::clear(out, vm.renderSamples);
     }
+    vm.voices[i].renderNextBlock(out, vm.renderSamples, *vm.renderLfos[part], vm.neighborLevel[(size_t)i]);
+}
 
-    // Poly 1 & Unison: Steal Oldest (Standard)
-    int oldestIndex = -1;
-    uint64_t minTimestamp = UINT64_MAX;
-    
-    // Priority 1: Steal Release phase first
-    for (int i = 0; i < currentActiveVoices; ++i) {
-        if (voices[i].isActive() && !voices[i].isGateOnActive()) { 
-             if (voiceTimestamps[i] < minTimestamp) {
-                minTimestamp = voiceTimestamps[i];
-                oldestIndex = i;
-            }
-        }
+void JunoVoiceManager::setPolyMode(int mode) {
+    if (polyMode != mode) {
+        polyMode = mode;
+        resetAllVoices(); // [Fidelidad] Limpiar todo al cambiar modo
     }
-    
-    // Priority 2: Steal Oldest Active
-    if (oldestIndex == -1) {
-         for (int i = 0; i < currentActiveVoices; ++i) {
-            if (voices[i].isActive()) { 
-                 if (voiceTimestamps[i] < minTimestamp) {
-                    minTimestamp = voiceTimestamps[i];
-                    oldestIndex = i;
-                }
-            }
+}
+
+void JunoVoiceManager::setVoiceLimit(int numVoices) {
+    numVoices = juce::jlimit(1, poolSize, numVoices);
+    if (numVoices == currentActiveVoices) return;
+
+    currentActiveVoices = numVoices;
+    resetAllVoices(); // Also restarts the Poly 1 cycle
+    setAllowedVoices(numVoices);
+}
+
+void JunoVoiceManager::noteOn(int midiChannel, int midiNote, float velocity) {
+    const int part = partForChannel(midiChannel);
+    if (part < 0) return;
+
+    // UNISON (Mode 3): Trigger all voices within the limit (single-timbral only: it takes the whole pool)
+    if (polyMode == 3 && numParts == 1) {
+        bool isLegatoTransition = isAnyNoteHeld();
+        for (int i = 0; i < allowedVoices; ++i) { // CPU governor: fewer stacked voices while shedding
+            startVoice(i, midiNote, velocity, isLegatoTransition);
         }
+        lastAllocatedVoiceIndex.store(0);
+        return;
     }
-    
-    // [Fidelidad] If we steal for Poly 1, should we update nextPoly1Index?
-    // The cycle logic is for *finding free*. Stealing is separate.
-    return oldestIndex;
+
+    // POLY (Mode 1 & 2): Allocation logic for single voice
+    // 1. Buscar si la nota ya está sonando para hacer Retrigger
+    int voiceIndex = allocator.voiceForNote(midiNote, part);
+
+    // 2. Buscar una voz libre (Poly 1: ciclo {0, 2, 4, 1, 3, 5}, Poly 2: índice más bajo)
+    //    CPU governor: at the allowed polyphony, steal instead
+    if (voiceIndex == -1 && allocator.getNumSounding() < allowedVoices) voiceIndex = allocator.acquireFree(polyMode);
+
+    // 3. Si no hay libres, robar (Poly 2: nota más aguda, Poly 1: la más antigua, en release primero)
+    if (voiceIndex == -1) voiceIndex = allocator.findVoiceToSteal(polyMode);
+
+    if (voiceIndex != -1) startVoice(voiceIndex, midiNote, velocity, false, part);
 }
 
+void JunoVoiceManager::noteOff(int midiChannel, int midiNote, float /*velocity*/) {
+    const int part = partForChannel(midiChannel);
+    if (part < 0) return;
+
+    if (polyMode == 3 && numParts == 1) { // UNISON
+        for (int i = 0; i < currentActiveVoices; ++i) {
+             if (getVoiceNote(i) == midiNote) releaseVoice(i);
+        }
+        return;
+    }
+
+    const int i = allocator.voiceForNote(midiNote, part);
+    if (i != -1) releaseVoice(i);
+}
 
 void JunoVoiceManager::outputActiveVoiceInfo() {
     juce::String state;
     for (int i = 0; i < currentActiveVoices; ++i) {
-        state += "[" + juce::String(i) + ":" + (voices[i].isActive() ? juce::String(voices[i].getCurrentNote()) : ".") + "] ";
+        state += "[" + juce::String(i) + ":" + (isVoiceActive(i) ? juce::String(getVoiceNote(i)) : ".") + "] ";
     }
     DBG("Voices: " << state);
 }
 
 void JunoVoiceManager::setAllNotesOff() {
     for (auto& voice : voices) voice.noteOff();
+    for (int i = 0; i < poolSize; ++i) voiceBank.noteOff(i);
+    allocator.allReleased();
 }
 
-bool JunoVoiceManager::anyVoiceActive() const {
-    for (const auto& v : voices) if (v.isActive()) return true;
-    return false;
-}
-
-void JunoVoiceManager::setBenderAmount(float v) {
-    for (auto& voice : voices) voice.setBender(v);
+void JunoVoiceManager::setBenderAmount(float v, int part) {
+    forEachVoiceOf(part, [v](Voice& voice) { voice.setBender(v); });
+    if (part == kAllParts || numParts == 1) voiceBank.setBender(v);
+    for (int p = 0; p < numParts; ++p) if (part == kAllParts || p == part) partParams[(size_t)p].benderValue = v;
 }
-void JunoVoiceManager::setPortamentoEnabled(bool b) {
-    for (auto& voice : voices) voice.setPortamentoEnabled(b);
+void JunoVoiceManager::setPortamentoEnabled(bool b, int part) {
+    forEachVoiceOf(part, [b](Voice& voice) { voice.setPortamentoEnabled(b); });
+    if (part == kAllParts || numParts == 1) voiceBank.setPortamentoEnabled(b);
+    for (int p = 0; p < numParts; ++p) if (part == kAllParts || p == part) partParams[(size_t)p].portamentoOn = b;
 }
-void JunoVoiceManager::setPortamentoTime(float v) {
-    for (auto& voice : voices) voice.setPortamentoTime(v);
+void JunoVoiceManager::setPortamentoTime(float v, int part) {
+    forEachVoiceOf(part, [v](Voice& voice) { voice.setPortamentoTime(v); });
+    if (part == kAllParts || numParts == 1) voiceBank.setPortamentoTime(v);
+    for (int p = 0; p < numParts; ++p) if (part == kAllParts || p == part) partParams[(size_t)p].portamentoTime = v;
 }
-void JunoVoiceManager::setPortamentoLegato(bool b) {
-    for (auto& voice : voices) voice.setPortamentoLegato(b);
+void JunoVoiceManager::setPortamentoLegato(bool b, int part) {
+    forEachVoiceOf(part, [b](Voice& voice) { voice.setPortamentoLegato(b); });
+    if (part == kAllParts || numParts == 1) voiceBank.setPortamentoLegato(b);
+    for (int p = 0; p < numParts; ++p) if (part == kAllParts || p == part) partParams[(size_t)p].portamentoLegato = b;
 }
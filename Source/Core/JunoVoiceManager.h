@@ -2,75 +2,240 @@
 
 #include <JuceHeader.h>
 #include "../Synth/Voice.h"
+#include "../Synth/JunoVoiceBank.h"
 #include "SynthParams.h"
+#include "RealtimeSentinel.h"
+#include "JunoWorkerPool.h"
+#include "JunoVoiceAllocator.h"
+#include <algorithm>
 #include <array>
+#include <vector>
+
+#ifndef JUNO_SIMD_VOICE_BANK
+ #define JUNO_SIMD_VOICE_BANK 1
+#endif
+
+#ifndef JUNO_VOICE_POOL_SIZE
+ #define JUNO_VOICE_POOL_SIZE 16
+#endif
+
+#ifndef JUNO_PARALLEL_VOICES
+ #define JUNO_PARALLEL_VOICES 0
+#endif
+
+#ifndef JUNO_TAIL_FLOOR_DB
+ #define JUNO_TAIL_FLOOR_DB -96.0 // Release tails predicted below this, at the output, are retired (-inf = off)
+#endif
+
+#ifndef JUNO_VOICE_CPU_BUDGET
+ #define JUNO_VOICE_CPU_BUDGET 0.7 // Share of each block's realtime the voices may take (0 = governor off)
+#endif
 
 /**
  * JunoVoiceManager
  * 
- * Handles the allocation and lifecycle of 6 fixed voices.
+ * Handles the allocation and lifecycle of a pool of voices (16 by default, up
+ * to kMaxPoolSize for stacked patches). Allocation goes through JunoVoiceAllocator,
+ * so note-on cost does not grow with the pool.
+ *
+ * Two render engines share the same allocation logic:
+ * - VoiceObjects: one Voice instance per voice (reference implementation).
+ * - VoiceBank: JunoVoiceBank, all voices as SIMD lanes (default).
+ *
+ * With parallel rendering on, VoiceObjects voices are spread over the shared
+ * JunoWorkerPool; each thread sums into its own scratch bus.
+ *
+ * CPU governor: render time is measured against a budget (a share of realtime)
+ * over ~10ms windows. Over budget, allowed polyphony drops to what fits and the
+ * quietest voices are shed with a 5ms fade, releasing voices before held ones;
+ * new notes then steal instead of growing past the cap. Allowed polyphony climbs
+ * back one voice per window once load is well under budget.
+ *
+ * Tail culling: a released voice keeps its full DCO / VCF / HPF cost until the
+ * ADSR reaches Idle, long after it went inaudible. After each render, every
+ * releasing voice predicts its level at the next envelope DAC step (release rate,
+ * VCA level, VCF direction, 8-bit DAC); once that is below the floor (relative to
+ * the master level) with kTailHeadroom to spare, it is retired with the shed fade.
+ *
+ * Multitimbral (setNumParts > 1): MIDI channel n plays part n - 1. Parts share
+ * the pool and the allocator; each voice takes its part's patch when it starts
+ * and renders into that part's bus with that part's LFO (renderParts). Voices
+ * then need their own parameters, so multitimbral runs the VoiceObjects engine.
+ *
+ * [Safety] Owned by the audio thread: no locks anywhere. UI threads reach it
+ * only through the processor's JunoEventQueue, drained at the start of processBlock.
  */
 class JunoVoiceManager {
 public:
-    JunoVoiceManager();
-    
+    enum class RenderEngine { VoiceObjects, VoiceBank };
+
+    static constexpr int kMaxPoolSize = JunoVoiceBank::kMaxVoices;
+    static constexpr int kMaxParts = JunoVoiceAllocator::kMaxParts;
+    static constexpr int kAllParts = -1; // Parameter setters: every voice, whatever its part
+
+    explicit JunoVoiceManager(int poolSize = JUNO_VOICE_POOL_SIZE);
+
+    /** Voices allocated (1..kMaxPoolSize); the voice limit becomes the pool size. Allocates: call off the audio thread, before prepare(). */
+    void setPoolSize(int numVoices);
+    int getPoolSize() const { return poolSize; }
+
+    /** 1 = single-timbral (MIDI channel ignored), up to kMaxParts. Call off the audio thread, before prepare(). */
+    void setNumParts(int numParts);
+    int getNumParts() const { return numParts; }
+    int partForChannel(int midiChannel) const; // -1: channel not played in multitimbral mode
+
     void prepare(double sampleRate, int maxBlockSize);
     
-    void renderNextBlock(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, const std::vector<float>& lfoBuffer);
+    void renderNextBlock(float* bus, int numSamples, const std::vector<float>& lfoBuffer); // Adds all voices into a mono bus
+    void renderParts(float* const* partBuses, const std::vector<float>* const* partLfos, int numSamples); // Multitimbral: one bus / LFO per part
     
     void noteOn(int midiChannel, int midiNote, float velocity);
     void noteOff(int midiChannel, int midiNote, float velocity);
     void outputActiveVoiceInfo(); 
     
-    void updateParams(const SynthParams& params);
+    void updateParams(const SynthParams& params, juce::uint32 dirty = SynthParamDirty::All, int part = kAllParts); // SynthParamDirty groups
+    void setThermalDrift(float drift); // Sounding voices now, the rest when they start
     void forceUpdate(); // [Fix] Instant parameter update for patch load
     
     void setPolyMode(int mode); 
+    void setVoiceLimit(int numVoices); // Voices available to the allocator (1..pool size)
+    int getVoiceLimit() const { return currentActiveVoices; }
     int getLastTriggeredVoiceIndex() const { return lastAllocatedVoiceIndex; }
     void setAllNotesOff();
     
-    void setBenderAmount(float v);
-    void setPortamentoEnabled(bool b);
-    void setPortamentoTime(float v);
-    void setPortamentoLegato(bool b);
+    void setBenderAmount(float v, int part = kAllParts);
+    void setPortamentoEnabled(bool b, int part = kAllParts);
+    void setPortamentoTime(float v, int part = kAllParts);
+    void setPortamentoLegato(bool b, int part = kAllParts);
     
+    void setRenderEngine(RenderEngine engine); // Multitimbral: applied once back to a single part
+    RenderEngine getRenderEngine() const { return useVoiceBank.load() ? RenderEngine::VoiceBank : RenderEngine::VoiceObjects; }
+
+    // [Optimization] VoiceObjects engine only. Set (with the engine) before prepare(): the pool threads start there
+    void setParallelRendering(bool enabled) { parallelRendering = enabled; }
+    bool isParallelRendering() const { return parallelRendering; }
+
+    /** Voice render time allowed per block, as a share of the block's realtime (0 = off). Any thread. */
+    void setCpuBudget(float shareOfRealtime) { cpuBudget.store(juce::jmax(0.0f, shareOfRealtime)); }
+    float getCpuBudget() const { return cpuBudget.load(); }
+    // [Determinism] Offline and seeded renders never shed: the result must not depend on the machine
+    void setLoadGovernorEnabled(bool enabled) { governorEnabled = enabled; }
+
+    struct LoadGovernorState {
+        bool shedding = false;       // Allowed polyphony below the voice limit
+        int allowedVoices = 0;
+        float load = 0.0f;           // Last window's render time / realtime
+        juce::uint32 overBudgetWindows = 0;
+        juce::uint32 shedEvents = 0; // Windows that shed voices or lowered the cap
+        juce::uint32 voicesShed = 0;
+    };
+    LoadGovernorState getLoadGovernorState() const; // Any thread
+
+    /** Tail culling floor in dB, relative to the master output level (-inf = off). Any thread. */
+    void setTailFloorDb(float dB) { tailFloorDb.store(dB); }
+    float getTailFloorDb() const { return tailFloorDb.load(); }
+    void setMasterGain(float gain) { masterGain = gain; } // Audio thread, before rendering: scales the tail floor
+    juce::uint32 getNumTailsCulled() const { return tailsCulled.load(std::memory_order_relaxed); } // Any thread
+
     void resetAllVoices() {
         for (auto& v : voices) v.forceStop();
+        voiceBank.reset();
         setAllNotesOff();
+        allocator.reset(currentActiveVoices);
     }
 
     float getTotalEnvelopeLevel() const {
         float sum = 0.0f;
-        for (int i = 0; i < currentActiveVoices; ++i) if (voices[i].isActive()) sum += voices[i].lastActiveOutputLevel();
+        allocator.forEachSounding([&](int i) { sum += getVoiceLevel(i); });
         return sum;
     }
 
-    int getActiveVoiceCount() const {
-        int count = 0;
-        for (int i = 0; i < currentActiveVoices; ++i) if (voices[i].isActive()) count++;
-        return count;
-    }
+    const JunoHPFCoefficients& getHpfCoefficients() const { return hpfCoefficients; }
 
-    bool isAnyNoteHeld() const {
-        for (int i = 0; i < currentActiveVoices; ++i) if (voices[i].isGateOnActive()) return true;
-        return false;
-    }
+    int getActiveVoiceCount() const { return allocator.getNumSounding(); }
+    int getActiveVoiceCount(int part) const { return allocator.getNumSounding(part); }
+    bool isAnyNoteHeld() const { return allocator.anyGateOn(); }
+    bool isAnyNoteHeld(int part) const { return allocator.anyGateOn(part); }
 
 private:
-    static constexpr int MAX_VOICES = 16;
-    int currentActiveVoices = 8;
-    std::array<Voice, MAX_VOICES> voices;
-    
-    std::array<std::atomic<uint64_t>, MAX_VOICES> voiceTimestamps;
-    std::atomic<uint64_t> currentTimestamp {0};
+    int poolSize = 0;
+    int currentActiveVoices = 0; // Voice limit, the pool size unless setVoiceLimit narrows it
+    std::vector<Voice> voices; // poolSize entries, never resized on the audio thread
+    JunoVoiceBank voiceBank;
+    JunoHPFCoefficients hpfCoefficients; // Shared by every voice, rebuilt only on sample rate change
+    JunoCurveTables::EnvelopeRates envelopeRates; // Same, for the MCU-tick envelope coefficients
+    JunoNoiseBank noiseBank;                      // Shared noise source (DCO noise + VCA ripple)
+    bool noiseEnabled = false;                    // Noise slider up: colour the shared noise
+    std::atomic<bool> useVoiceBank { JUNO_SIMD_VOICE_BANK != 0 };
+    bool voiceBankRequested = JUNO_SIMD_VOICE_BANK != 0; // Engine to restore when leaving multitimbral mode
+
+    // Multitimbral parts
+    int numParts = 1;
+    float thermalDrift = 0.0f, curvedThermalDrift = 0.0f; // Last setThermalDrift, for voices started later
+    std::array<SynthParams, kMaxParts> partParams; // Last patch pushed per part; voices load it when they change part
+    std::vector<int> voicePart;                     // Part each voice last played (poolSize entries)
+
+    // Parallel VoiceObjects rendering (see renderVoiceTask)
+    static void renderVoiceTask(void* context, int taskIndex, int slot);
+    juce::SharedResourcePointer<JunoWorkerPool> workerPool;
+    bool parallelRendering = JUNO_PARALLEL_VOICES != 0;
+    std::array<std::vector<float>, JunoWorkerPool::kMaxSlots> slotBus; // One mono scratch bus per thread
+    std::vector<int> renderList;       // Voices rendered this block
+    std::vector<float> neighborLevel;  // Crosstalk source, taken before any voice renders
+    std::vector<float> voiceScratch;   // Multitimbral parallel: one chunk per voice, summed into its part afterwards
+    int scratchStride = 0;
+    float* const* renderBuses = nullptr;
+    const std::vector<float>* const* renderLfos = nullptr;
+    int renderSamples = 0;
     
+    JunoVoiceAllocator allocator; // Free list, age heaps, note map (O(log n) allocation)
+
+    // CPU governor (see governLoad). Window state and the cap belong to the audio thread
+    static constexpr float kGovernorWindowMs = 10.0f;
+    static constexpr float kShedFadeMs = 5.0f;
+    static constexpr float kRecoverShare = 0.75f; // Regain a voice below this share of the budget
+    static constexpr int kOverBudgetWindowsToShed = 2; // One slow window (preemption) is not a trend
+    std::atomic<float> cpuBudget { (float)JUNO_VOICE_CPU_BUDGET };
+    bool governorEnabled = true;
+    double sampleRate = 44100.0;
+    int governorWindow = 441;
+    int shedFadeSamples = 220;
+    juce::int64 windowTicks = 0;
+    int windowSamples = 0;
+    int overBudgetStreak = 0;
+    int allowedVoices = 8;
+    std::vector<int> shedCandidates;
+    std::atomic<int> publishedAllowed { 8 };
+    std::atomic<bool> publishedShedding { false };
+    std::atomic<float> publishedLoad { 0.0f };
+    std::atomic<juce::uint32> overBudgetWindows { 0 }, shedEvents { 0 }, voicesShed { 0 };
+
+    // Tail culling (see cullInaudibleTails)
+    static constexpr float kTailHeadroom = 2.0f; // 6dB margin on the prediction
+    std::atomic<float> tailFloorDb { (float)JUNO_TAIL_FLOOR_DB };
+    float cachedFloorDb = 1.0f;   // tailFloorDb the gain below was computed from (1 = not yet)
+    float tailFloorGain = 0.0f;
+    float masterGain = 1.0f;
+    std::atomic<juce::uint32> tailsCulled { 0 };
+
     std::atomic<int> lastAllocatedVoiceIndex {-1}; 
     std::atomic<int> polyMode {1}; 
     
-    bool anyVoiceActive() const;
-    int findFreeVoiceIndex();
-    int findVoiceToSteal();
+    // Engine routing: allocation code talks to voices only through these
+    bool isVoiceActive(int i) const { return useVoiceBank.load() ? voiceBank.isActive(i) : voices[i].isActive(); }
+    int getVoiceNote(int i) const { return useVoiceBank.load() ? voiceBank.getCurrentNote(i) : voices[i].getCurrentNote(); }
+    float getVoiceLevel(int i) const { return useVoiceBank.load() ? voiceBank.lastActiveOutputLevel(i) : voices[i].lastActiveOutputLevel(); }
+    bool isVoiceShedding(int i) const { return useVoiceBank.load() ? voiceBank.isShedding(i) : voices[i].isShedding(); }
+    void startVoice(int i, int note, float velocity, bool isLegato, int part = 0);
+    void renderVoiceObjects(float* const* buses, const std::vector<float>* const* lfos, int numSamples);
+    void updateNoiseEnabled();
+    template <typename Fn> void forEachVoiceOf(int part, Fn&& fn); // fn(Voice&) for every voice of part (all for kAllParts)
+    void releaseVoice(int i);
+    void governLoad(juce::int64 renderTicks, int numSamples); // After each render: budget check, shed / recover
+    int shedQuietestVoices(int count);
+    void shedVoice(int i);
+    void cullInaudibleTails(); // After each render: retire releasing voices predicted below the floor
+    void setAllowedVoices(int numVoices);
 
-    juce::CriticalSection lock;
-    int nextPoly1Index = 0; // [Fidelidad] Authentic Cyclic allocation state
+    void reclaimFinishedVoices(); // Hands voices that went idle while rendering back to the allocator
 };
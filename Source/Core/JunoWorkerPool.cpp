@@ -0,0 +1,148 @@
+// Source/Core/JunoWorkerPool.cpp
+#include "JunoWorkerPool.h"
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+#elif JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#else
+ #include <semaphore.h>
+ #include <cerrno>
+#endif
+
+/** Counting semaphore whose post() never takes a lock (WaitableEvent::signal does). */
+class JunoWorkerPool::WakeSemaphore {
+public:
+   #if JUCE_WINDOWS
+    WakeSemaphore() : handle(CreateSemaphoreW(nullptr, 0, kMaxSlots * 1024, nullptr)) {}
+    ~WakeSemaphore() { CloseHandle(handle); }
+    void post(int count) noexcept { ReleaseSemaphore(handle, count, nullptr); }
+    void wait() noexcept { WaitForSingleObject(handle, INFINITE); }
+   #elif JUCE_MAC || JUCE_IOS
+    WakeSemaphore() : handle(dispatch_semaphore_create(0)) {}
+    ~WakeSemaphore() { dispatch_release(handle); }
+    void post(int count) noexcept { while (--count >= 0) dispatch_semaphore_signal(handle); }
+    void wait() noexcept { dispatch_semaphore_wait(handle, DISPATCH_TIME_FOREVER); }
+   #else
+    WakeSemaphore() { sem_init(&handle, 0, 0); }
+    ~WakeSemaphore() { sem_destroy(&handle); }
+    void post(int count) noexcept { while (--count >= 0) sem_post(&handle); }
+    void wait() noexcept { while (sem_wait(&handle) != 0 && errno == EINTR) {} }
+   #endif
+
+private:
+   #if JUCE_WINDOWS
+    HANDLE handle;
+   #elif JUCE_MAC || JUCE_IOS
+    dispatch_semaphore_t handle;
+   #else
+    sem_t handle;
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE(WakeSemaphore)
+};
+
+class JunoWorkerPool::Worker : public juce::Thread {
+public:
+    Worker(JunoWorkerPool& p, int s) : juce::Thread("JunoVoiceWorker"), pool(p), slot(s) {}
+
+    void run() override {
+        // Catches the next render chunk of the same block; between host callbacks the worker sleeps
+        const juce::int64 spinTicks = juce::Time::secondsToHighResolutionTicks(kSpinMicros * 1.0e-6);
+        juce::uint32 seen = generationOf(pool.state.load(std::memory_order_acquire));
+        juce::int64 idleSince = juce::Time::getHighResolutionTicks();
+
+        while (!threadShouldExit()) {
+            const juce::uint32 current = generationOf(pool.state.load(std::memory_order_acquire));
+            if (current != seen) {
+                seen = current;
+                pool.work(current, slot);
+                idleSince = juce::Time::getHighResolutionTicks();
+                continue;
+            }
+            if (juce::Time::getHighResolutionTicks() - idleSince < spinTicks) continue;
+
+            // Register before the last check: run() publishes the job, then reads sleepers
+            pool.sleepers.fetch_add(1, std::memory_order_seq_cst);
+            if (generationOf(pool.state.load(std::memory_order_seq_cst)) == seen && !threadShouldExit())
+                pool.wake->wait();
+            pool.sleepers.fetch_sub(1, std::memory_order_seq_cst);
+            idleSince = juce::Time::getHighResolutionTicks();
+        }
+    }
+
+private:
+    static constexpr double kSpinMicros = 20.0;
+
+    JunoWorkerPool& pool;
+    const int slot;
+};
+
+JunoWorkerPool::JunoWorkerPool() : wake(std::make_unique<WakeSemaphore>()) {}
+
+JunoWorkerPool::~JunoWorkerPool() {
+    for (auto& w : workers) w->signalThreadShouldExit();
+    wake->post((int)workers.size()); // Sleeping workers see the exit flag
+    for (auto& w : workers) w->stopThread(1000);
+}
+
+void JunoWorkerPool::start() {
+    const std::lock_guard<std::mutex> sl(startMutex);
+    if (!workers.empty()) return;
+
+    const int count = juce::jlimit(0, kMaxSlots - 1, juce::SystemStats::getNumPhysicalCpus() - 1);
+    for (int i = 0; i < count; ++i) {
+        workers.push_back(std::make_unique<Worker>(*this, i + 1));
+        if (!workers.back()->startRealtimeThread(juce::Thread::RealtimeOptions{}.withPriority(9)))
+            workers.back()->startThread();
+    }
+    numWorkers.store(count, std::memory_order_release);
+}
+
+bool JunoWorkerPool::claim(juce::uint32 gen, int& taskIndex) noexcept {
+    juce::uint64 s = state.load(std::memory_order_acquire);
+    for (;;) {
+        const int next = (int)(s & 0xffff);
+        const int count = (int)((s >> 16) & 0xffff);
+        if (generationOf(s) != gen || next >= count) return false;
+        if (state.compare_exchange_weak(s, s + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            taskIndex = next;
+            return true;
+        }
+    }
+}
+
+void JunoWorkerPool::work(juce::uint32 gen, int slot) noexcept {
+    // A successful claim means the job is still in flight: jobTask / jobContext belong to it
+    int taskIndex = 0;
+    while (claim(gen, taskIndex)) {
+        jobTask(jobContext, taskIndex, slot);
+        tasksDone.fetch_add(1, std::memory_order_acq_rel);
+    }
+}
+
+void JunoWorkerPool::run(Task task, void* context, int numTasks) noexcept {
+    if (numTasks <= 0) return;
+
+    bool expected = false;
+    if (numWorkers.load(std::memory_order_acquire) == 0 || numTasks == 1 || numTasks > 0xffff
+        || !busy.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+        for (int i = 0; i < numTasks; ++i) task(context, i, 0);
+        return;
+    }
+
+    jobTask = task;
+    jobContext = context;
+    tasksDone.store(0, std::memory_order_relaxed);
+    const juce::uint32 gen = ++generation;
+    state.store(((juce::uint64)gen << 32) | ((juce::uint64)numTasks << 16), std::memory_order_seq_cst);
+
+    // Wake sleepers for the tasks beyond the caller's own (extra posts only cost a spurious loop)
+    const int asleep = sleepers.load(std::memory_order_seq_cst);
+    if (asleep > 0) wake->post(juce::jmin(asleep, numTasks - 1));
+
+    work(gen, 0);
+    while (tasksDone.load(std::memory_order_acquire) < numTasks) {} // Only tasks already running on workers
+
+    busy.store(false, std::memory_order_release);
+}
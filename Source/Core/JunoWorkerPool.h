@@ -0,0 +1,70 @@
+// Source/Core/JunoWorkerPool.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * JunoWorkerPool - Process-wide realtime worker threads for voice rendering
+ *
+ * One pool per process, shared by every plugin instance through
+ * juce::SharedResourcePointer. Threads are only created by start() (off the
+ * audio thread) and stop with the last owner.
+ *
+ * run() hands a batch of tasks to the workers without locks or allocation:
+ * - The job is published as one atomic word (generation | task count | next task),
+ *   and workers and caller claim task indices from it by CAS.
+ * - The calling audio thread works as slot 0, so a batch always completes even when
+ *   the workers are asleep; run() only spins for tasks a worker has already claimed.
+ * - If another instance holds the pool, the batch runs inline on the caller.
+ *
+ * Idle workers spin for a few microseconds after each job (the next render chunk of
+ * the same block follows straight away), then block on a semaphore. run() posts it
+ * only when a worker sleeps; posting never locks, so it is safe on the audio thread.
+ *
+ * Only the VoiceObjects engine uses the pool (JUNO_PARALLEL_VOICES needs
+ * JUNO_SIMD_VOICE_BANK=OFF, or a switch to RenderEngine::VoiceObjects before prepare).
+ */
+class JunoWorkerPool {
+public:
+    static constexpr int kMaxSlots = 8; // Caller + up to 7 workers
+
+    /** task(context, taskIndex, slot): slot identifies the executing thread (0 = caller). */
+    using Task = void (*)(void* context, int taskIndex, int slot);
+
+    JunoWorkerPool();
+    ~JunoWorkerPool();
+
+    /** Creates the worker threads (one per spare physical core). Message thread; idempotent. */
+    void start();
+    int getNumSlots() const noexcept { return 1 + numWorkers.load(std::memory_order_acquire); }
+
+    /** Runs every task in [0, numTasks) and returns once all are done. Realtime-safe. */
+    void run(Task task, void* context, int numTasks) noexcept;
+
+private:
+    class Worker;
+    class WakeSemaphore;
+
+    static juce::uint32 generationOf(juce::uint64 s) noexcept { return (juce::uint32)(s >> 32); }
+    bool claim(juce::uint32 generation, int& taskIndex) noexcept;
+    void work(juce::uint32 generation, int slot) noexcept;
+
+    std::atomic<juce::uint64> state { 0 }; // generation (32) | task count (16) | next task (16)
+    std::atomic<int> tasksDone { 0 };
+    std::atomic<bool> busy { false };      // Held by the instance whose batch is in flight
+    std::atomic<int> sleepers { 0 };       // Workers blocked (or about to block) on wake
+    juce::uint32 generation = 0;           // Written under busy
+    Task jobTask = nullptr;                // Stable while any task of the job is unclaimed
+    void* jobContext = nullptr;
+
+    std::unique_ptr<WakeSemaphore> wake;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<int> numWorkers { 0 };
+    std::mutex startMutex; // start() only: never taken on the audio thread
+
+    JUCE_DECLARE_NON_COPYABLE(JunoWorkerPool)
+};
@@ -4,55 +4,62 @@
 
 PerformanceState::PerformanceState() : noteOffFifo(256)
 {
-    sustainPedalActive = false;
+    sustainPedalMask = 0;
 }
 
-void PerformanceState::handleSustain (int value)
+void PerformanceState::handleSustain (int channel, int value)
 {
-    const bool newState = (value >= 64);
-    if (!newState && sustainPedalActive)
+    const juce::uint32 bit = (juce::uint32) channelBit (channel);
+    if (value >= 64)
     {
-        sustainPedalActive = false;
-        // Notes are released from outside by calling flushSustain
+        sustainPedalMask.fetch_or (bit);
     }
-    else
+    else if ((sustainPedalMask.fetch_and (~bit) & bit) != 0)
     {
-        sustainPedalActive = newState;
+        releasePending = true; // Notes are released from outside by calling flushSustain
     }
 }
 
-void PerformanceState::handleNoteOff (int note, JunoVoiceManager& vm)
+void PerformanceState::handleNoteOff (int channel, int note, JunoVoiceManager& vm)
 {
-    if (sustainPedalActive.load())
+    if ((sustainPedalMask.load() & (juce::uint32) channelBit (channel)) != 0)
     {
         // Push to FIFO (Audio Thread Safe)
         int start1, size1, start2, size2;
         noteOffFifo.prepareToWrite(1, start1, size1, start2, size2);
-        if (size1 > 0) noteOffBuffer[start1] = note;
-        else if (size2 > 0) noteOffBuffer[start2] = note;
+        const int entry = ((channel - 1) & 15) * 128 + (note & 127);
+        if (size1 > 0) noteOffBuffer[start1] = entry;
+        else if (size2 > 0) noteOffBuffer[start2] = entry;
         noteOffFifo.finishedWrite(size1 + size2);
     }
     else
     {
-        vm.noteOff (1, note, 0.0f);
+        vm.noteOff (channel, note, 0.0f);
     }
 }
 
 void PerformanceState::flushSustain (JunoVoiceManager& vm)
 {
-    if (!sustainPedalActive.load())
-    {
-        // Determine how many items to read
-        int numReady = noteOffFifo.getNumReady();
-        if (numReady > 0) {
-            int start1, size1, start2, size2;
-            noteOffFifo.prepareToRead(numReady, start1, size1, start2, size2);
-            
-            for (int i = 0; i < size1; ++i) vm.noteOff(1, noteOffBuffer[start1 + i], 0.0f);
-            for (int i = 0; i < size2; ++i) vm.noteOff(1, noteOffBuffer[start2 + i], 0.0f);
-            
-            noteOffFifo.finishedRead(size1 + size2);
+    if (!releasePending) return;
+    releasePending = false;
+
+    // Release the notes of channels whose pedal is up; the others go back in the FIFO
+    const juce::uint32 held = sustainPedalMask.load();
+    int numReady = noteOffFifo.getNumReady();
+    for (int n = 0; n < numReady; ++n) {
+        int start1, size1, start2, size2;
+        noteOffFifo.prepareToRead(1, start1, size1, start2, size2);
+        const int entry = noteOffBuffer[size1 > 0 ? start1 : start2];
+        noteOffFifo.finishedRead(1);
+
+        const int channel = entry / 128 + 1;
+        if ((held & (juce::uint32) channelBit (channel)) == 0) {
+            vm.noteOff (channel, entry % 128, 0.0f);
+            continue;
         }
+        noteOffFifo.prepareToWrite(1, start1, size1, start2, size2);
+        noteOffBuffer[size1 > 0 ? start1 : start2] = entry;
+        noteOffFifo.finishedWrite(1);
     }
 }
 // [Fix] Implementation of updateParams
@@ -11,17 +11,21 @@ struct PerformanceState
     PerformanceState();
     ~PerformanceState() = default;
 
-    void handleSustain (int value);
-    void handleNoteOff (int note, JunoVoiceManager& vm);
+    // Channels 1-16: the pedal holds the notes of its own channel (one per multitimbral part)
+    void handleSustain (int channel, int value);
+    void handleNoteOff (int channel, int note, JunoVoiceManager& vm);
     void flushSustain (JunoVoiceManager& vm);
     void updateParams(const struct SynthParams& p);
 
     juce::AbstractFifo noteOffFifo; 
-    std::array<int, 256> noteOffBuffer;
+    std::array<int, 256> noteOffBuffer; // (channel - 1) * 128 + note
 
     bool isLegatoActive() const { return noteOffFifo.getNumReady() > 0; }
 
     
 private:
-    std::atomic<bool> sustainPedalActive { false };
+    static int channelBit (int channel) { return 1 << ((channel - 1) & 15); }
+
+    std::atomic<juce::uint32> sustainPedalMask { 0 }; // Bit n: pedal down on channel n + 1
+    bool releasePending = false;                      // A pedal went up since the last flush
 };
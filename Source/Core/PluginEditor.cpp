@@ -188,6 +188,9 @@ void SimpleJuno106AudioProcessorEditor::timerCallback()
         // Update SysEx Display when patch changes
     }
     
+    // Host notes on the on-screen keyboard (published lock-free by processBlock)
+    audioProcessor.syncKeyboardDisplay();
+
     // Always update SysEx Display (real-time feedback for all param changes)
     auto dump = audioProcessor.getCurrentSysExData();
     if (dump.getRawDataSize() > 0) {
@@ -4,9 +4,12 @@
  #include "PluginEditor.h"
 #endif
 #include "PresetManager.h"
+#include "RealtimeSentinel.h"
+#include "JunoRandom.h"
+#include "../Synth/JunoCurveTables.h"
 
 //==============================================================================
-SimpleJuno106AudioProcessor::SimpleJuno106AudioProcessor()
+SimpleJuno106AudioProcessor::SimpleJuno106AudioProcessor(int voicePoolSize)
 #ifndef JucePlugin_PreferredChannelConfigurations
      : AudioProcessor (BusesProperties()
                      #if ! JucePlugin_IsMidiEffect
@@ -19,7 +22,8 @@ SimpleJuno106AudioProcessor::SimpleJuno106AudioProcessor()
 #else
     : AudioProcessor(JucePlugin_PreferredChannelConfigurations),
 #endif
-      apvts(*this, &undoManager, "Parameters", createParameterLayout())
+      apvts(*this, &undoManager, "Parameters", createParameterLayout()),
+      voiceManager(voicePoolSize)
 {
 #if JUCE_HEADLESS_PLUGIN
     DBG("SimpleJuno106AudioProcessor::Constructor START (HEADLESS=1)");
@@ -47,7 +51,10 @@ SimpleJuno106AudioProcessor::SimpleJuno106AudioProcessor()
     midiLearnHandler.bind(32, "vcaLevel");
     keyboardState.addListener(this);
 
-    keyboardState.addListener(this);
+    // [Safety] Scratch memory is bounded by the fixed render chunk, never by the host block
+    lfoBuffer.resize((size_t)kRenderChunk);
+    voiceBus.resize((size_t)kRenderChunk);
+    midiOutBuffer.ensureSize(256);
 
     // [Optimization] Initialize Cached Pointers
     auto getParam = [&](const juce::String& id) {
@@ -66,6 +73,7 @@ SimpleJuno106AudioProcessor::SimpleJuno106AudioProcessor()
     fmtNoise = getParam("noise");
     fmtLfoToDCO = getParam("lfoToDCO");
     fmtHpfFreq = getParam("hpfFreq");
+    fmtBusHpf = getParam("busHpf");
     fmtVcfFreq = getParam("vcfFreq");
     fmtResonance = getParam("resonance");
     fmtEnvAmount = getParam("envAmount");
@@ -93,10 +101,45 @@ SimpleJuno106AudioProcessor::SimpleJuno106AudioProcessor()
     fmtTune = getParam("tune");
     fmtMasterVol = getParam("masterVolume");
     fmtMidiOut = getParam("midiOut");
+
+    for (auto* param : getParameters()) {
+        auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(param);
+        parameterDirtyBits.push_back(ranged != nullptr ? SynthParamDirty::forParameterID(ranged->getParameterID())
+                                                       : SynthParamDirty::All);
+        param->addListener(this);
+    }
+    SynthParams fieldLayout;
+    SynthParamFields::forEach([this](const char* id, juce::uint32, const auto&) {
+        panelFieldParams.push_back(dynamic_cast<juce::RangedAudioParameter*>(apvts.getParameter(id)));
+    }, fieldLayout);
+
+    if (JUNO_MULTITIMBRAL_PARTS > 1)
+        setMultitimbral(JUNO_MULTITIMBRAL_PARTS, JUNO_PER_PART_CHORUS ? ChorusRouting::PerPart : ChorusRouting::Shared);
     DBG("SimpleJuno106AudioProcessor::Constructor END");
 }
 
 SimpleJuno106AudioProcessor::~SimpleJuno106AudioProcessor() {
+    stopTimer();
+    for (auto* param : getParameters())
+        param->removeListener(this);
+}
+
+void SimpleJuno106AudioProcessor::parameterValueChanged(int parameterIndex, float) {
+    // Any thread (host automation, UI, MIDI learn inside processBlock): lock-free, no string lookups
+    markParametersDirty(juce::isPositiveAndBelow(parameterIndex, (int)parameterDirtyBits.size())
+                            ? parameterDirtyBits[(size_t)parameterIndex] : SynthParamDirty::All);
+}
+
+void SimpleJuno106AudioProcessor::markParametersDirty(juce::uint32 groups) {
+    paramDirtyMask.fetch_or(groups, std::memory_order_relaxed);
+    paramVersion.fetch_add(1, std::memory_order_release); // Published after the mask
+}
+
+juce::uint32 SimpleJuno106AudioProcessor::consumeParameterChanges() {
+    const auto version = paramVersion.load(std::memory_order_acquire);
+    if (version == seenParamVersion) return 0; // Idle knobs: one atomic load per block
+    seenParamVersion = version;
+    return paramDirtyMask.exchange(0, std::memory_order_acquire);
 }
 
 const juce::String SimpleJuno106AudioProcessor::getName() const { return JucePlugin_Name; }
@@ -124,33 +167,55 @@ void SimpleJuno106AudioProcessor::prepareToPlay (double sr, int samplesPerBlock)
     // [QA-SynthOps] Commandment 4: Latency Reporting
     setLatencySamples(0);
 
-    voiceManager.prepare(sr, samplesPerBlock);
+    // [Determinism] Seeded renders: reseed the processor-level sources and restart every
+    // free-running drift/phase so the same MIDI renders identically (see JunoRandom)
+    if (JunoRandom::isSeeded()) {
+        mainChorus.seed(0);
+        JunoRandom::seed(thermalNoiseGen, JunoRandom::Stream::ChorusNoise);
+        thermalCounter = 0;
+        driftPushCounter = 0;
+        driftPushDue = true;
+        thermalTarget = 0.0f;
+        globalDriftAudible = 0.0f;
+        powerOnDelaySamples = 0;
+    }
+
+    voiceManager.setLoadGovernorEnabled(!isNonRealtime() && !JunoRandom::isSeeded()); // Bounces keep every voice
+    voiceManager.prepare(sr, kRenderChunk);
+    if (isMultitimbral()) {
+        // Parts are marked dirty below; an All mark here would copy the whole panel over the edit part
+        mirroredParams = getMirrorParameters();
+        panelPart = -1; // First block loads the edit part into the panel
+    } else {
+        markParametersDirty(SynthParamDirty::All); // Freshly prepared voices get the full patch on the first block
+    }
+    busHpf.prepare(voiceManager.getHpfCoefficients(), kRenderChunk);
     DBG("SimpleJuno106AudioProcessor::voiceManager prepared");
-    juce::dsp::ProcessSpec spec { sr, (juce::uint32)samplesPerBlock, 2 };
-    chorus.prepare(spec);
-    chorus.reset();
-    chorus2.prepare(spec); // [Fidelidad] Second BBD Line
-    chorus2.reset();
-    
-    // [Safety] Pre-allocate LFO buffer
-    lfoBuffer.resize(samplesPerBlock + 128); // Standard safety margin
+    mainChorus.prepare(sr, kRenderChunk);
 
-    dcBlocker.prepare(spec); 
+    for (size_t p = 0; p < parts.size(); ++p) {
+        auto& part = *parts[p];
+        part.busHpf.prepare(voiceManager.getHpfCoefficients(), kRenderChunk);
+        part.dirty = SynthParamDirty::All;
+        part.lfoPhase = part.lfoDelayEnvelope = 0.0f;
+        part.wasAnyNoteHeld = false;
+        if (part.chorus == nullptr) continue;
+        if (JunoRandom::isSeeded()) part.chorus->seed(1 + (int)p);
+        part.chorus->prepare(sr, kRenderChunk);
+    }
+
+    // Output stages run once over the host buffer
+    juce::dsp::ProcessSpec outputSpec { sr, (juce::uint32)juce::jmax(1, samplesPerBlock), 2 };
+    dcBlocker.prepare(outputSpec); 
     *dcBlocker.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(sr, 20.0f);
     
-    chorusPreEmphasisFilter.prepare(spec);
-    chorusDeEmphasisFilter.prepare(spec);
-    chorusNoiseFilter.prepare(spec);
-    
-    *chorusPreEmphasisFilter.state = *juce::dsp::IIR::Coefficients<float>::makeHighShelf(sr, 8000.0f, 0.707f, 1.5f);
+    chorusDeEmphasisFilter.prepare(outputSpec);
     *chorusDeEmphasisFilter.state = *juce::dsp::IIR::Coefficients<float>::makeLowPass(sr, 12000.0f, 0.707f);
-    *chorusNoiseFilter.state = *juce::dsp::IIR::Coefficients<float>::makeLowPass(sr, 8000.0f, 0.707f);
-
-    chorusNoiseBuffer.setSize(2, samplesPerBlock);
 
     masterLfoPhase = 0.0f; 
     masterLfoDelayEnvelope = 0.0f; 
     wasAnyNoteHeld = false;
+    silenceTracker.prepare(sr);
     DBG("SimpleJuno106AudioProcessor::prepareToPlay END");
 }
 
@@ -164,8 +229,9 @@ bool SimpleJuno106AudioProcessor::isBusesLayoutSupported (const BusesLayout& lay
 
 void SimpleJuno106AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    JUNO_RT_SECTION // [Debug] Traps allocations/locks when built with JUNO_RT_SENTINEL
     static bool firstBlock = true;
-    if (firstBlock) { DBG("SimpleJuno106AudioProcessor::processBlock FIRST CALL"); firstBlock = false; }
+    if (firstBlock) { JUNO_RT_EXEMPT DBG("SimpleJuno106AudioProcessor::processBlock FIRST CALL"); firstBlock = false; }
 
     juce::ScopedNoDenormals noDenormals;
     const int numSamples = buffer.getNumSamples();
@@ -174,39 +240,245 @@ void SimpleJuno106AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
     for (auto i = getTotalNumInputChannels(); i < getTotalNumOutputChannels(); ++i) 
         buffer.clear (i, 0, numSamples);
 
-    keyboardState.processNextMidiBuffer (midiMessages, 0, numSamples, true);
+    // [Safety] UI notes / panic arrive through the lock-free queue. Host notes reach the keyboard
+    // display through hostNotes (atomics): MidiKeyboardState takes a lock, so it stays off this thread
+    drainUiEvents();
 
     // 1. MIDI Handling
-    for (const auto metadata : midiMessages) {
-        const auto message = metadata.getMessage();
-        if (message.isSysEx()) { sysExEngine.handleIncomingSysEx(message, currentParams); continue; }
-        if (message.isController()) {
-            if (message.getControllerNumber() == 1) { 
-                if (auto* p = apvts.getParameter("benderToLFO")) p->setValueNotifyingHost(message.getControllerValue() / 127.0f); 
+    // [Fidelidad] Sample-accurate: the block is split at event timestamps and each event lands at the
+    // start of its sub-block. Events less than kMinSubBlock past a split are applied early, at that split.
+    auto nextEvent = midiMessages.begin();
+    const auto lastEvent = midiMessages.end();
+    auto applyEventsBefore = [&](int samplePosition) {
+        for (; nextEvent != lastEvent && (*nextEvent).samplePosition < samplePosition; ++nextEvent)
+            handleMidiEvent((*nextEvent).getMessage());
+        performanceState.flushSustain(voiceManager);
+    };
+
+    // 2./3. Parameter Mirroring, Modulations & Voice Updates (repeated per sub-block, after its events)
+    applyEventsBefore(kMinSubBlock);
+    const bool paramsEdited = applyParameterChanges() != 0;
+
+    // [Optimization] Idle bypass: a started voice, an edit or a pending event wakes the chain before anything renders
+    const bool voicesActive = voiceManager.getActiveVoiceCount() > 0;
+    if (voicesActive || paramsEdited || nextEvent != lastEvent) silenceTracker.wake();
+    if (silenceTracker.isSilent()) {
+        // Output stays cleared; free-running LFOs advance so resuming lands on the same phase
+        const float lfoRateHz = JunoCurveTables::get().lfoRateHz((float)currentParams.lfoRate);
+        auto advance = [numSamples](float& phase, float inc) { phase += inc * (float)numSamples; phase -= std::floor(phase); };
+        advance(masterLfoPhase, lfoRateHz / (float)sr);
+        mainChorus.advance(numSamples);
+        masterLfoDelayEnvelope = 0.0f;
+        wasAnyNoteHeld = false;
+        for (auto& part : parts) {
+            advance(part->lfoPhase, JunoCurveTables::get().lfoRateHz((float)part->params.lfoRate) / (float)sr);
+            part->lfoDelayEnvelope = 0.0f;
+            part->wasAnyNoteHeld = false;
+            if (part->chorus != nullptr) part->chorus->advance(numSamples);
+        }
+        advanceThermalDrift(numSamples);
+        flushMidiOut(midiMessages);
+        return;
+    }
+
+    const float masterVol = fmtMasterVol->load();
+    voiceManager.setMasterGain(masterVol); // Tail culling floor follows the master level
+    float* outL = buffer.getWritePointer(0);
+    float* outR = buffer.getNumChannels() > 1 ? buffer.getWritePointer(1) : nullptr;
+    float busPeak = 0.0f;
+    bool chorusUsed = false;
+
+    // [Optimization] Fixed internal chunks (kRenderChunk), further split at MIDI events
+    for (int chunkStart = 0; chunkStart < numSamples;) {
+        if (chunkStart > 0) {
+            applyEventsBefore(chunkStart + kMinSubBlock);
+            applyParameterChanges();
+        }
+        int chunkSize = juce::jmin(kRenderChunk, numSamples - chunkStart);
+        if (nextEvent != lastEvent)
+            chunkSize = juce::jmin(chunkSize, (*nextEvent).samplePosition - chunkStart); // >= kMinSubBlock
+
+        if (isMultitimbral()) {
+            // 4.-7. per part: LFO, voices and bus HPF, then the shared or per-part chorus
+            busPeak = juce::jmax(busPeak, renderPartsChunk(outL + chunkStart, outR != nullptr ? outR + chunkStart : nullptr,
+                                                           chunkSize, masterVol, chorusUsed));
+            advanceThermalDrift(chunkSize);
+            chunkStart += chunkSize;
+            continue;
+        }
+
+        // 4. LFO Generation (Master)
+        const float lfoRateHz = JunoCurveTables::get().lfoRateHz((float)currentParams.lfoRate);
+        const float lfoDelaySeconds = currentParams.lfoDelay * 5.0f;
+        const float delayIncrement = (lfoDelaySeconds > 0.001f) ? (1.0f / (lfoDelaySeconds * (float)sr)) : 1.0f;
+
+        const bool anyHeld = voiceManager.isAnyNoteHeld();
+        if (anyHeld && !wasAnyNoteHeld) masterLfoDelayEnvelope = 0.0f;
+        wasAnyNoteHeld = anyHeld;
+
+        renderMasterLfo(chunkSize, lfoRateHz / (float)sr, delayIncrement, anyHeld);
+
+        // 5. Voice Rendering
+        // [Optimization] All voices sum into one mono bus; the Juno voice path is mono up to the chorus
+        float* bus = voiceBus.data();
+        juce::FloatVectorOperations::clear(bus, chunkSize);
+        voiceManager.renderNextBlock(bus, chunkSize, lfoBuffer);
+        if (currentParams.busHpf) {
+            // [Fidelidad] One HPF / bass shelf on the sum, as on the hardware (voices skip theirs)
+            busHpf.setPosition(currentParams.hpfFreq);
+            busHpf.process(bus, chunkSize);
+        }
+        const auto busRange = juce::FloatVectorOperations::findMinAndMax(bus, chunkSize);
+        busPeak = juce::jmax(busPeak, -busRange.getStart(), busRange.getEnd());
+
+        // 6. Global PSU Sag
+        float envSum = voiceManager.getTotalEnvelopeLevel();
+        float sagGain = 1.0f - (envSum * 0.025f);
+        if (sagGain < 0.8f) sagGain = 0.8f;
+        juce::FloatVectorOperations::multiply(bus, sagGain * masterVol, chunkSize);
+
+        // 7. Chorus Processing: the only stage that creates the stereo image
+        if (const int chorusMode = JunoChorus::modeFor(currentParams); chorusMode != 0) {
+            mainChorus.process(bus, outL + chunkStart, outR != nullptr ? outR + chunkStart : nullptr, chunkSize, chorusMode);
+            chorusUsed = true;
+        } else {
+            juce::FloatVectorOperations::copy(outL + chunkStart, bus, chunkSize);
+            if (outR != nullptr) juce::FloatVectorOperations::copy(outR + chunkStart, bus, chunkSize);
+        }
+        advanceThermalDrift(chunkSize); // Reaches the voices with the next chunk's parameter pass
+        chunkStart += chunkSize;
+    }
+    applyEventsBefore(std::numeric_limits<int>::max()); // Stray timestamps past the block end
+    flushMidiOut(midiMessages); // Input events are done with: the buffer may grow now
+
+    // Voice bus level decides Active/Tail/Silent (pre-chorus, so hiss is ignored)
+    silenceTracker.update(voiceManager.getActiveVoiceCount() > 0, busPeak, numSamples);
+
+    if (chorusUsed) {
+        juce::dsp::AudioBlock<float> block(buffer);
+        juce::dsp::ProcessContextReplacing<float> context(block);
+        chorusDeEmphasisFilter.process(context);
+
+        // Simple Soft Saturation (Master Stage)
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+            float* d = buffer.getWritePointer(ch);
+            for (int i = 0; i < numSamples; ++i) {
+                d[i] = std::tanh(d[i] * 1.1f); // Subtle drive + safety clip
             }
-            else if (message.getControllerNumber() == 64) {
-                 int val = message.getControllerValue();
-                 if (sustainInverted) val = 127 - val;
-                 performanceState.handleSustain(val);
+        }
+
+        // Stereo Crosstalk (Analog leakage)
+        if (buffer.getNumChannels() > 1) {
+            float* l = buffer.getWritePointer(0);
+            float* r = buffer.getWritePointer(1);
+            for (int i = 0; i < numSamples; ++i) {
+                float vL = l[i], vR = r[i];
+                l[i] = vL + vR * 0.03f;
+                r[i] = vR + vL * 0.03f;
             }
-            else midiLearnHandler.handleIncomingCC(message.getControllerNumber(), message.getControllerValue(), apvts);
-            continue;
         }
-        if (message.isPitchWheel()) {
-            if (auto* p = apvts.getParameter("bender")) 
-                p->setValueNotifyingHost(p->convertTo0to1(((float)message.getPitchWheelValue() / 8192.0f) - 1.0f));
-            continue;
+    }
+
+    // 8. Power-On Pop & DC Block
+    if (powerOnDelaySamples < (int)(0.080f * sr)) {
+        if (powerOnDelaySamples == 0) {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch) buffer.addSample(ch, 0, 4.0f);
         }
-        if (message.isNoteOn()) voiceManager.noteOn(message.getChannel(), message.getNoteNumber(), message.getVelocity());
-        else if (message.isNoteOff()) performanceState.handleNoteOff(message.getNoteNumber(), voiceManager);
+        powerOnDelaySamples += numSamples;
     }
-    performanceState.flushSustain(voiceManager);
 
-    // 2. Parameter Mirroring & SysEx MIDI Out
-    currentParams = getMirrorParameters();
-    
+    juce::dsp::AudioBlock<float> block(buffer);
+    juce::dsp::ProcessContextReplacing<float> context(block);
+    dcBlocker.process(context);
+}
+
+void SimpleJuno106AudioProcessor::handleMidiEvent(const juce::MidiMessage& message) {
+    hostNotes.track(message);
+    if (isMultitimbral() && handlePartMidiEvent(message)) return;
+    // Single-timbral: sustain and note-offs ignore the channel, as the voices do
+    const int channel = isMultitimbral() ? message.getChannel() : 1;
+
+    if (message.isSysEx()) { sysExEngine.handleIncomingSysEx(message, currentParams); return; }
+    if (message.isController()) {
+        if (message.getControllerNumber() == 1) { 
+            if (auto* p = apvts.getParameter("benderToLFO")) p->setValueNotifyingHost(message.getControllerValue() / 127.0f); 
+        }
+        else if (message.getControllerNumber() == 64) {
+             int val = message.getControllerValue();
+             if (sustainInverted) val = 127 - val;
+             performanceState.handleSustain(channel, val);
+        }
+        else midiLearnHandler.handleIncomingCC(message.getControllerNumber(), message.getControllerValue(), apvts);
+        return;
+    }
+    if (message.isPitchWheel()) {
+        if (auto* p = apvts.getParameter("bender")) 
+            p->setValueNotifyingHost(p->convertTo0to1(((float)message.getPitchWheelValue() / 8192.0f) - 1.0f));
+        return;
+    }
+    if (message.isNoteOn()) voiceManager.noteOn(message.getChannel(), message.getNoteNumber(), message.getVelocity());
+    else if (message.isNoteOff()) performanceState.handleNoteOff(channel, message.getNoteNumber(), voiceManager);
+}
+
+void SimpleJuno106AudioProcessor::advanceThermalDrift(int numSamples) {
+    // [Global Thermal Drift] Rates are per 512 samples, so the drift no longer depends on the host block
+    constexpr int kRetargetSamples = 1024 * 512;
+    thermalCounter += numSamples;
+    if (thermalCounter > kRetargetSamples) {
+        thermalCounter = 0;
+        thermalTarget = (thermalNoiseGen.nextFloat() * 2.0f - 1.0f) * 1.5f;
+    }
+    globalDriftAudible += (thermalTarget - globalDriftAudible) * (0.0005f * (float)numSamples / 512.0f);
+
+    // [Optimization] The drift moves a few thousandths per 512 samples: the voices follow it at that rate
+    constexpr int kDriftPushSamples = 512;
+    driftPushCounter += numSamples;
+    if (driftPushCounter >= kDriftPushSamples) {
+        driftPushCounter = 0;
+        driftPushDue = true;
+    }
+}
+
+juce::uint32 SimpleJuno106AudioProcessor::applyParameterChanges() {
+    // [Optimization] The APVTS atomics are only re-read when a listener bumped the version
+    juce::uint32 dirty = consumeParameterChanges();
+    if (midiChannel != mirroredParams.midiChannel) dirty |= SynthParamDirty::System;
+    if (dirty != 0) mirroredParams = getMirrorParameters();
+    currentParams = mirroredParams;
+    applyPerformanceModulations(currentParams);
+    currentParams.thermalDrift = globalDriftAudible;
+
+    if (isMultitimbral()) {
+        applyPartChanges(dirty); // The panel only reaches the edit part's voices
+        return dirty;
+    }
+
+    // [Optimization] Only dirty groups reach the voices; drift and bender are pushed as single fields
+    if (dirty != 0) {
+        voiceManager.updateParams(currentParams, dirty);
+        voiceManager.setPortamentoEnabled(currentParams.portamentoOn);
+        voiceManager.setPortamentoTime(currentParams.portamentoTime);
+        voiceManager.setPortamentoLegato(currentParams.portamentoLegato);
+    }
+    if (pendingForceUpdate) {
+        voiceManager.forceUpdate(); // [Fix] Preset/state load: snap smoothers once the new params are in
+        pendingForceUpdate = false;
+    }
+    if (dirty != 0 || driftPushDue) {
+        voiceManager.setThermalDrift(globalDriftAudible); // The voices add it to the bender CV
+        driftPushDue = false;
+    }
+    if (dirty != 0 || currentParams.benderValue != appliedVoiceBender) {
+        voiceManager.setBenderAmount(currentParams.benderValue);
+        appliedVoiceBender = currentParams.benderValue;
+    }
+    return dirty;
+}
+
+void SimpleJuno106AudioProcessor::flushMidiOut(juce::MidiBuffer& midiMessages) {
+    const SynthParams& panel = mirroredParams; // Unmodulated panel values
     // [Senior Audit] Thread-Safe SysEx Generation & Rate Limiting
-    if (currentParams.midiOut) {
+    if (panel.midiOut) {
         int msgsSent = 0;
         const int kMaxMsgsPerBlock = 2;
         auto checkSend = [&](float curr, float& last, int id) {
@@ -218,22 +490,22 @@ void SimpleJuno106AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
             }
         };
 
-        checkSend(currentParams.lfoRate, lastParams.lfoRate, JunoSysEx::LFO_RATE);
-        checkSend(currentParams.lfoDelay, lastParams.lfoDelay, JunoSysEx::LFO_DELAY);
-        checkSend(currentParams.lfoToDCO, lastParams.lfoToDCO, JunoSysEx::DCO_LFO);
-        checkSend(currentParams.pwmAmount, lastParams.pwmAmount, JunoSysEx::DCO_PWM);
-        checkSend(currentParams.noiseLevel, lastParams.noiseLevel, JunoSysEx::DCO_NOISE);
-        checkSend(currentParams.vcfFreq, lastParams.vcfFreq, JunoSysEx::VCF_FREQ);
-        checkSend(currentParams.resonance, lastParams.resonance, JunoSysEx::VCF_RES);
-        checkSend(currentParams.envAmount, lastParams.envAmount, JunoSysEx::VCF_ENV);
-        checkSend(currentParams.lfoToVCF, lastParams.lfoToVCF, JunoSysEx::VCF_LFO);
-        checkSend(currentParams.kybdTracking, lastParams.kybdTracking, JunoSysEx::VCF_KYBD);
-        checkSend(currentParams.vcaLevel, lastParams.vcaLevel, JunoSysEx::VCA_LEVEL);
-        checkSend(currentParams.attack, lastParams.attack, JunoSysEx::ENV_A);
-        checkSend(currentParams.decay, lastParams.decay, JunoSysEx::ENV_D);
-        checkSend(currentParams.sustain, lastParams.sustain, JunoSysEx::ENV_S);
-        checkSend(currentParams.release, lastParams.release, JunoSysEx::ENV_R);
-        checkSend(currentParams.subOscLevel, lastParams.subOscLevel, JunoSysEx::DCO_SUB);
+        checkSend(panel.lfoRate, lastParams.lfoRate, JunoSysEx::LFO_RATE);
+        checkSend(panel.lfoDelay, lastParams.lfoDelay, JunoSysEx::LFO_DELAY);
+        checkSend(panel.lfoToDCO, lastParams.lfoToDCO, JunoSysEx::DCO_LFO);
+        checkSend(panel.pwmAmount, lastParams.pwmAmount, JunoSysEx::DCO_PWM);
+        checkSend(panel.noiseLevel, lastParams.noiseLevel, JunoSysEx::DCO_NOISE);
+        checkSend(panel.vcfFreq, lastParams.vcfFreq, JunoSysEx::VCF_FREQ);
+        checkSend(panel.resonance, lastParams.resonance, JunoSysEx::VCF_RES);
+        checkSend(panel.envAmount, lastParams.envAmount, JunoSysEx::VCF_ENV);
+        checkSend(panel.lfoToVCF, lastParams.lfoToVCF, JunoSysEx::VCF_LFO);
+        checkSend(panel.kybdTracking, lastParams.kybdTracking, JunoSysEx::VCF_KYBD);
+        checkSend(panel.vcaLevel, lastParams.vcaLevel, JunoSysEx::VCA_LEVEL);
+        checkSend(panel.attack, lastParams.attack, JunoSysEx::ENV_A);
+        checkSend(panel.decay, lastParams.decay, JunoSysEx::ENV_D);
+        checkSend(panel.sustain, lastParams.sustain, JunoSysEx::ENV_S);
+        checkSend(panel.release, lastParams.release, JunoSysEx::ENV_R);
+        checkSend(panel.subOscLevel, lastParams.subOscLevel, JunoSysEx::DCO_SUB);
 
         // [Hardware Authenticity] Pack Switches 1/2 logic
         auto packSw1 = [](const SynthParams& p) -> int {
@@ -246,7 +518,7 @@ void SimpleJuno106AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
             }
             return val;
         };
-        int s1cur = packSw1(currentParams);
+        int s1cur = packSw1(panel);
         int s1last = packSw1(lastParams);
         if (s1cur != s1last) {
             midiOutBuffer.addEvent(JunoSysEx::createParamChange(midiChannel - 1, JunoSysEx::SWITCHES_1, s1cur), 0);
@@ -262,7 +534,7 @@ void SimpleJuno106AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
             val |= (hwHpf & 0x03) << 3;
             return val;
         };
-        int s2cur = packSw2(currentParams);
+        int s2cur = packSw2(panel);
         int s2last = packSw2(lastParams);
         if (s2cur != s2last) {
             midiOutBuffer.addEvent(JunoSysEx::createParamChange(midiChannel - 1, JunoSysEx::SWITCHES_2, s2cur), 0);
@@ -277,149 +549,265 @@ void SimpleJuno106AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
         }
         midiOutBuffer.clear();
     }
-    lastParams = currentParams;
+    lastParams = panel;
+}
 
-    // 3. DSP Modulations & Voice Updates
-    applyPerformanceModulations(currentParams);
-    
-    // [Global Thermal Drift]
-    if (++thermalCounter > 1024) {
-        thermalCounter = 0;
-        thermalTarget = (chorusNoiseGen.nextFloat() * 2.0f - 1.0f) * 1.5f;
+void SimpleJuno106AudioProcessor::setMultitimbral(int numParts, ChorusRouting routing, int voicesPerPart) {
+    numParts = juce::jlimit(1, kMaxParts, numParts);
+    voiceManager.setNumParts(numParts);
+    // [Fix] Parts share the pool: the limit must cover all of them, not a single-timbral count
+    voiceManager.setVoiceLimit(voicesPerPart > 0 ? numParts * voicesPerPart : voiceManager.getPoolSize());
+    chorusRouting = routing;
+    parts.clear();
+    panelPart = -1;
+    panelLoadRequested = false;
+    panelLoadPart.store(-1);
+    {
+        const juce::SpinLock::ScopedLockType lock(partSnapshotLock);
+        partSnapshot.clear();
     }
-    globalDriftAudible += (thermalTarget - globalDriftAudible) * 0.0005f;
-    currentParams.thermalDrift = globalDriftAudible;
+    if (numParts == 1) {
+        stopTimer();
+        return;
+    }
+    startTimerHz(30); // Panel loads requested by the audio thread (syncPanelToEditPart)
 
-    voiceManager.updateParams(currentParams);
-    voiceManager.setPortamentoEnabled(currentParams.portamentoOn);
-    voiceManager.setPortamentoTime(currentParams.portamentoTime);
-    voiceManager.setPortamentoLegato(currentParams.portamentoLegato);
-    voiceManager.setBenderAmount(currentParams.benderValue + globalDriftAudible);
-
-    // 4. LFO Generation (Master)
-    float ratio = JunoTimeCurves::kLfoMaxHz / JunoTimeCurves::kLfoMinHz;
-    float lfoRateHz = JunoTimeCurves::kLfoMinHz * std::pow(ratio, (float)currentParams.lfoRate);
-    float lfoDelaySeconds = currentParams.lfoDelay * 5.0f;
-    float delayIncrement = (lfoDelaySeconds > 0.001f) ? (1.0f / (lfoDelaySeconds * (float)sr)) : 1.0f;
-    
-    bool anyHeld = voiceManager.isAnyNoteHeld();
-    if (anyHeld && !wasAnyNoteHeld) masterLfoDelayEnvelope = 0.0f;
-    wasAnyNoteHeld = anyHeld;
-    
-    if (lfoBuffer.size() < (size_t)numSamples) lfoBuffer.resize(numSamples + 128);
+    const SynthParams panel = getMirrorParameters(); // Every part starts from the panel patch
+    mirroredParams = panel;
+    for (int p = 0; p < numParts; ++p) {
+        auto part = std::make_unique<Part>();
+        part->patch = panel;
+        part->lfo.assign((size_t)kRenderChunk, 0.0f);
+        part->bus.assign((size_t)kRenderChunk, 0.0f);
+        if (routing == ChorusRouting::PerPart) part->chorus = std::make_unique<JunoChorus>();
+        parts.push_back(std::move(part));
+    }
+    partOutBuffer.setSize(2, kRenderChunk);
 
-    for (int i = 0; i < numSamples; ++i) {
-        masterLfoPhase += (lfoRateHz / (float)sr);
-        if (masterLfoPhase >= 1.0f) masterLfoPhase -= 1.0f;
-        
-        if (anyHeld) {
-            masterLfoDelayEnvelope += delayIncrement;
-            if (masterLfoDelayEnvelope > 1.0f) masterLfoDelayEnvelope = 1.0f;
-        } else {
-            masterLfoDelayEnvelope = 0.0f;
-        }
+    const juce::SpinLock::ScopedLockType lock(partSnapshotLock);
+    partSnapshot.assign((size_t)numParts, panel);
+}
 
-        float lfoTri = 2.0f * std::abs(2.0f * (masterLfoPhase - 0.5f)) - 1.0f;
-        float lfoTriStepped = std::floor(lfoTri * 15.99f) / 15.0f; 
-        lfoBuffer[i] = lfoTriStepped * masterLfoDelayEnvelope;
+void SimpleJuno106AudioProcessor::setPartPatch(int channel, const SynthParams& patch) {
+    // The edit part's patch is also loaded into the panel when it arrives (applyPartChanges)
+    const int part = isMultitimbral() ? voiceManager.partForChannel(channel) : -1;
+    if (part < 0) return;
+    {
+        const juce::SpinLock::ScopedLockType lock(partSnapshotLock);
+        partSnapshot[(size_t)part] = patch; // Saved even if the host asks before the next block
     }
+    partPatches.push({ part, patch });
+}
 
-    // 5. Voice Rendering
-    voiceManager.renderNextBlock(buffer, 0, numSamples, lfoBuffer);
+bool SimpleJuno106AudioProcessor::handlePartMidiEvent(const juce::MidiMessage& message) {
+    int channel = message.getChannel();
+    if (message.isSysEx()) {
+        // [Fidelidad] As on a rack of 106s: dumps and param changes reach the part listening on their channel
+        int type = 0, ch = 0, p1 = 0, p2 = 0;
+        uint8_t dumpData[18];
+        if (!JunoSysEx::parseMessage(message, type, ch, p1, p2, dumpData)) return false;
+        channel = ch + 1;
+    }
+    if (channel == 0) return false; // System messages: panel
 
-    // 6. Global PSU Sag
-    float envSum = voiceManager.getTotalEnvelopeLevel();
-    float sagGain = 1.0f - (envSum * 0.025f);
-    if (sagGain < 0.8f) sagGain = 0.8f;
-    float masterVol = fmtMasterVol->load();
-    buffer.applyGain(sagGain * masterVol);
+    const int partIndex = voiceManager.partForChannel(channel);
+    if (partIndex < 0) return true; // No part listens on this channel
+    if (partIndex == getEditPart()) return false;
 
-    // 7. Chorus Processing
-    if (currentParams.chorus1 || currentParams.chorus2) {
-        juce::dsp::AudioBlock<float> block(buffer);
-        juce::dsp::ProcessContextReplacing<float> context(block);
-        chorusPreEmphasisFilter.process(context);
-        
-        juce::AudioBuffer<float> wetBuffer(2, numSamples);
-        wetBuffer.clear();
-        
-        int targetMode = (currentParams.chorus1 && currentParams.chorus2) ? 3 : (currentParams.chorus1 ? 1 : 2);
-        float phIncI = JunoChorusConstants::kRateI / (float)sr;
-        float phIncII = JunoChorusConstants::kRateII / (float)sr;
-        
-        // [Fidelidad] Generate filtered chorus hiss
-        for (int i = 0; i < numSamples; ++i) {
-            chorusNoiseBuffer.setSample(0, i, chorusNoiseGen.nextFloat() * 2.0f - 1.0f);
-            chorusNoiseBuffer.setSample(1, i, chorusNoiseGen.nextFloat() * 2.0f - 1.0f);
+    auto& part = *parts[(size_t)partIndex];
+    if (message.isSysEx()) {
+        sysExEngine.handleIncomingSysEx(message, part.patch);
+        part.dirty = SynthParamDirty::All;
+    } else if (message.isController()) {
+        // Other controllers are panel MIDI learn, taken on the edit channel only
+        if (message.getControllerNumber() == 1) {
+            part.patch.benderToLFO = message.getControllerValue() / 127.0f;
+            part.dirty |= SynthParamDirty::Performance | SynthParamDirty::Dco | SynthParamDirty::Vcf; // Feeds lfoToDCO / vcfLFOAmount
+        } else if (message.getControllerNumber() == 64) {
+            const int val = message.getControllerValue();
+            performanceState.handleSustain(channel, sustainInverted ? 127 - val : val);
         }
-        juce::dsp::AudioBlock<float> noiseBlock(chorusNoiseBuffer);
-        juce::dsp::ProcessContextReplacing<float> noiseContext(noiseBlock);
-        chorusNoiseFilter.process(noiseContext);
-        
-        // Noise levels: Mode II is slightly noiser (~6dB more? Let's use 0.0004 for I, 0.0008 for II)
-        float noiseLevel = (targetMode == 2) ? 0.0008f : 0.0004f;
-        if (targetMode == 3) noiseLevel = 0.0006f; // Mode I+II
-
-        for (int i = 0; i < numSamples; ++i) {
-            float dry = buffer.getSample(0, i);
-            chorusLfoPhaseI = std::fmod(chorusLfoPhaseI + phIncI, 1.0f);
-            chorusLfoPhaseII = std::fmod(chorusLfoPhaseII + phIncII, 1.0f);
-            
-            float lfoI = 2.0f * std::abs(2.0f * (chorusLfoPhaseI - 0.5f)) - 1.0f;
-            float lfoII = 2.0f * std::abs(2.0f * (chorusLfoPhaseII - 0.5f)) - 1.0f;
-            
-            float w1 = 0.0f, w2 = 0.0f;
-            if (targetMode == 1 || targetMode == 3) 
-                w1 = chorus.processSample(dry, JunoChorusConstants::kDelayI + (lfoI * JunoChorusConstants::kDepthI * 2.0f));
-            if (targetMode == 2 || targetMode == 3) 
-                w2 = chorus2.processSample(dry, JunoChorusConstants::kDelayII + (lfoII * JunoChorusConstants::kDepthII * 2.0f));
-            
-            float wetMix = (targetMode == 3) ? (w1 + w2) * 0.707f : (targetMode == 1 ? w1 : w2);
-            
-            // Add Hiss to wet signal
-            float hissL = chorusNoiseBuffer.getSample(0, i) * noiseLevel;
-            float hissR = chorusNoiseBuffer.getSample(1, i) * noiseLevel;
-            
-            wetBuffer.setSample(0, i, wetMix + hissL);
-            wetBuffer.setSample(1, i, -wetMix + hissR);
+    } else if (message.isPitchWheel()) {
+        part.patch.benderValue = ((float)message.getPitchWheelValue() / 8192.0f) - 1.0f;
+        part.dirty |= SynthParamDirty::Performance;
+    } else if (message.isNoteOn()) {
+        voiceManager.noteOn(channel, message.getNoteNumber(), message.getVelocity());
+    } else if (message.isNoteOff()) {
+        performanceState.handleNoteOff(channel, message.getNoteNumber(), voiceManager);
+    }
+    return true;
+}
+
+void SimpleJuno106AudioProcessor::applyPartChanges(juce::uint32 panelDirty) {
+    const int editPart = getEditPart();
+    bool reloadPanel = editPart != panelPart; // Edit channel switched (or first block after prepare)
+    partPatches.drain([this, editPart, &reloadPanel](const PartPatchEvent& e) {
+        parts[(size_t)e.part]->patch = e.patch;
+        parts[(size_t)e.part]->dirty = SynthParamDirty::All;
+        reloadPanel = reloadPanel || e.part == editPart;
+    });
+    panelPart = editPart;
+
+    // The panel shows the edit part; only the groups actually edited are copied back into it.
+    // [Safety] Loading the panel notifies the host once per parameter: the message thread does it
+    // (syncPanelToEditPart). Until then the panel still shows another patch, so it is not copied.
+    if (editPart >= 0) {
+        auto& edit = *parts[(size_t)editPart];
+        if (reloadPanel) {
+            panelLoadRequested = true; // Posted once the snapshot holds the patch
+        } else if (panelDirty != 0 && !panelLoadRequested && panelLoadPart.load(std::memory_order_acquire) < 0) {
+            SynthParamFields::copyGroups(mirroredParams, edit.patch, panelDirty);
+            edit.dirty |= panelDirty;
         }
-        
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-            buffer.addFrom(ch, 0, wetBuffer, ch, 0, numSamples, 1.0f);
-            
-        chorusDeEmphasisFilter.process(context);
+    }
 
-        // Simple Soft Saturation (Master Stage)
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
-            float* d = buffer.getWritePointer(ch);
-            for (int i = 0; i < numSamples; ++i) {
-                d[i] = std::tanh(d[i] * 1.1f); // Subtle drive + safety clip
-            }
+    bool anyDirty = false;
+    for (size_t p = 0; p < parts.size(); ++p) {
+        auto& part = *parts[p];
+        const int index = (int)p;
+        if (part.dirty != 0) {
+            part.params = part.patch;
+            applyPerformanceModulations(part.params);
+            part.params.thermalDrift = globalDriftAudible;
+            voiceManager.updateParams(part.params, part.dirty, index);
+            voiceManager.setPortamentoEnabled(part.params.portamentoOn, index);
+            voiceManager.setPortamentoTime(part.params.portamentoTime, index);
+            voiceManager.setPortamentoLegato(part.params.portamentoLegato, index);
         }
+        if (part.dirty != 0 || part.params.benderValue != part.appliedBender) {
+            voiceManager.setBenderAmount(part.params.benderValue, index);
+            part.appliedBender = part.params.benderValue;
+        }
+        anyDirty = anyDirty || part.dirty != 0;
+        part.dirty = 0;
+    }
 
-        // Stereo Crosstalk (Analog leakage)
-        if (buffer.getNumChannels() > 1) {
-            float* l = buffer.getWritePointer(0);
-            float* r = buffer.getWritePointer(1);
-            for (int i = 0; i < numSamples; ++i) {
-                float vL = l[i], vR = r[i];
-                l[i] = vL + vR * 0.03f;
-                r[i] = vR + vL * 0.03f;
-            }
+    // Published for getStateInformation and the panel load; the audio thread never waits for the lock
+    if (anyDirty || partSnapshotStale || panelLoadRequested) {
+        const juce::SpinLock::ScopedTryLockType lock(partSnapshotLock);
+        partSnapshotStale = !lock.isLocked();
+        if (lock.isLocked())
+            for (size_t p = 0; p < parts.size(); ++p) partSnapshot[p] = parts[p]->patch;
+    }
+    if (panelLoadRequested && !partSnapshotStale) {
+        panelLoadPart.store(editPart, std::memory_order_release);
+        panelLoadRequested = false;
+    }
+
+    if (pendingForceUpdate) {
+        voiceManager.forceUpdate(); // [Fix] Preset/state load: snap smoothers once the new params are in
+        pendingForceUpdate = false;
+    }
+    if (anyDirty || driftPushDue) {
+        voiceManager.setThermalDrift(globalDriftAudible);
+        driftPushDue = false;
+    }
+}
+
+void SimpleJuno106AudioProcessor::syncPanelToEditPart() {
+    // Taken before the panel moves: its echoes are copied back into the part as usual
+    const int part = panelLoadPart.exchange(-1, std::memory_order_acq_rel);
+    if (part < 0) return;
+
+    SynthParams patch;
+    {
+        const juce::SpinLock::ScopedLockType lock(partSnapshotLock);
+        if ((size_t)part >= partSnapshot.size()) return; // Layout changed since the request
+        patch = partSnapshot[(size_t)part];
+    }
+    loadPatchIntoPanel(patch); // Echoes back as panel edits of the same values
+}
+
+void SimpleJuno106AudioProcessor::loadPatchIntoPanel(const SynthParams& patch) {
+    // [Optimization] Parameters resolved in the constructor: no string lookups per load
+    size_t n = 0;
+    SynthParamFields::forEach([this, &n](const char*, juce::uint32, const auto& value) {
+        if (auto* p = panelFieldParams[n++]) p->setValueNotifyingHost(p->convertTo0to1((float)value));
+    }, patch);
+}
+
+float SimpleJuno106AudioProcessor::renderPartsChunk(float* outL, float* outR, int numSamples, float masterVol, bool& chorusUsed) {
+    const double sr = getSampleRate();
+    std::array<float*, kMaxParts> partBuses {};
+    std::array<const std::vector<float>*, kMaxParts> partLfos {};
+
+    // 4. LFO per part (parts without voices only advance their phase)
+    for (size_t p = 0; p < parts.size(); ++p) {
+        auto& part = *parts[p];
+        const float phaseIncrement = JunoCurveTables::get().lfoRateHz((float)part.params.lfoRate) / (float)sr;
+        const float lfoDelaySeconds = part.params.lfoDelay * 5.0f;
+        const float delayIncrement = (lfoDelaySeconds > 0.001f) ? (1.0f / (lfoDelaySeconds * (float)sr)) : 1.0f;
+
+        const bool anyHeld = voiceManager.isAnyNoteHeld((int)p);
+        if (anyHeld && !part.wasAnyNoteHeld) part.lfoDelayEnvelope = 0.0f;
+        part.wasAnyNoteHeld = anyHeld;
+
+        if (voiceManager.getActiveVoiceCount((int)p) > 0) {
+            renderLfo(part.lfo.data(), numSamples, part.lfoPhase, part.lfoDelayEnvelope, phaseIncrement, delayIncrement, anyHeld);
+        } else {
+            part.lfoPhase += phaseIncrement * (float)numSamples;
+            part.lfoPhase -= std::floor(part.lfoPhase);
+            part.lfoDelayEnvelope = 0.0f;
         }
+        juce::FloatVectorOperations::clear(part.bus.data(), numSamples);
+        partBuses[p] = part.bus.data();
+        partLfos[p] = &part.lfo;
     }
 
-    // 8. Power-On Pop & DC Block
-    if (powerOnDelaySamples < (int)(0.080f * sr)) {
-        if (powerOnDelaySamples == 0) {
-            for (int ch = 0; ch < buffer.getNumChannels(); ++ch) buffer.addSample(ch, 0, 4.0f);
+    // 5. One pass over the shared pool, every voice into its part's bus
+    voiceManager.renderParts(partBuses.data(), partLfos.data(), numSamples);
+
+    // 6. Global PSU Sag: one supply for the whole pool
+    const float sagGain = juce::jmax(0.8f, 1.0f - voiceManager.getTotalEnvelopeLevel() * 0.025f);
+    const float gain = sagGain * masterVol;
+
+    float* mix = voiceBus.data();
+    float* chorusL = partOutBuffer.getWritePointer(0);
+    float* chorusR = outR != nullptr ? partOutBuffer.getWritePointer(1) : nullptr;
+    juce::FloatVectorOperations::clear(mix, numSamples);
+    juce::FloatVectorOperations::clear(outL, numSamples);
+    if (outR != nullptr) juce::FloatVectorOperations::clear(outR, numSamples);
+
+    const bool perPartChorus = chorusRouting == ChorusRouting::PerPart;
+    float peak = 0.0f;
+    for (auto& partPtr : parts) {
+        auto& part = *partPtr;
+        float* bus = part.bus.data();
+        if (part.params.busHpf) {
+            part.busHpf.setPosition(part.params.hpfFreq);
+            part.busHpf.process(bus, numSamples);
         }
-        powerOnDelaySamples += numSamples;
+        const auto busRange = juce::FloatVectorOperations::findMinAndMax(bus, numSamples);
+        peak = juce::jmax(peak, -busRange.getStart(), busRange.getEnd());
+
+        const int chorusMode = perPartChorus ? JunoChorus::modeFor(part.params) : 0;
+        if (chorusMode == 0) {
+            juce::FloatVectorOperations::add(mix, bus, numSamples);
+            continue;
+        }
+
+        // 7. Per-part chorus
+        juce::FloatVectorOperations::multiply(bus, gain, numSamples);
+        part.chorus->process(bus, chorusL, chorusR, numSamples, chorusMode);
+        juce::FloatVectorOperations::add(outL, chorusL, numSamples);
+        if (outR != nullptr) juce::FloatVectorOperations::add(outR, chorusR, numSamples);
+        chorusUsed = true;
     }
 
-    juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
-    dcBlocker.process(context);
+    // 7. Remaining mix: through the shared chorus, switched from the panel (per-part routing: dry)
+    juce::FloatVectorOperations::multiply(mix, gain, numSamples);
+    const int sharedMode = perPartChorus ? 0 : JunoChorus::modeFor(currentParams);
+    const float* mixL = mix;
+    const float* mixR = mix;
+    if (sharedMode != 0) {
+        mainChorus.process(mix, chorusL, chorusR, numSamples, sharedMode);
+        mixL = chorusL;
+        mixR = chorusR;
+        chorusUsed = true;
+    }
+    juce::FloatVectorOperations::add(outL, mixL, numSamples);
+    if (outR != nullptr) juce::FloatVectorOperations::add(outR, mixR, numSamples);
+    return peak;
 }
 
 void SimpleJuno106AudioProcessor::enterTestMode(bool enter) { isTestMode = enter; }
@@ -440,8 +828,49 @@ void SimpleJuno106AudioProcessor::triggerTestProgram(int bankIndex) {
     setBool("chorus1", prog.chorus1); setBool("chorus2", prog.chorus2);
 }
 
-void SimpleJuno106AudioProcessor::handleNoteOn(juce::MidiKeyboardState*, int /*channel*/, int midiNoteNumber, float velocity) { voiceManager.noteOn(0, midiNoteNumber, velocity); }
-void SimpleJuno106AudioProcessor::handleNoteOff(juce::MidiKeyboardState*, int /*channel*/, int midiNoteNumber, float /*velocity*/) { performanceState.handleNoteOff(midiNoteNumber, voiceManager); }
+// [Safety] Host notes shown by syncKeyboardDisplay are already played from the MIDI buffer;
+// only on-screen keyboard notes are posted
+void SimpleJuno106AudioProcessor::handleNoteOn(juce::MidiKeyboardState*, int /*channel*/, int midiNoteNumber, float velocity) {
+    if (!mirroringHostNotes) uiEvents.postNoteOn(midiNoteNumber, velocity);
+}
+void SimpleJuno106AudioProcessor::handleNoteOff(juce::MidiKeyboardState*, int /*channel*/, int midiNoteNumber, float /*velocity*/) {
+    if (!mirroringHostNotes) uiEvents.postNoteOff(midiNoteNumber);
+}
+
+void SimpleJuno106AudioProcessor::syncKeyboardDisplay() {
+    JUCE_ASSERT_MESSAGE_THREAD
+    const juce::ScopedValueSetter<bool> mirroring(mirroringHostNotes, true);
+    for (int note = 0; note < 128; ++note) {
+        const bool held = hostNotes.isHeld(note);
+        if (held == displayedHostNotes[(size_t)note]) continue;
+        displayedHostNotes[(size_t)note] = held;
+        if (held) keyboardState.noteOn(midiChannel, note, 1.0f);
+        else keyboardState.noteOff(midiChannel, note, 0.0f);
+    }
+}
+
+void SimpleJuno106AudioProcessor::drainUiEvents() {
+    const int keyboardChannel = isMultitimbral() ? midiChannel : 1; // On-screen keyboard: plays the edit part
+    uiEvents.drain([this, keyboardChannel](const JunoEventQueue::Event& e) {
+        switch (e.type) {
+            case JunoEventQueue::Event::Type::NoteOn:  voiceManager.noteOn(keyboardChannel, e.note, e.velocity); break;
+            case JunoEventQueue::Event::Type::NoteOff: performanceState.handleNoteOff(keyboardChannel, e.note, voiceManager); break;
+            case JunoEventQueue::Event::Type::Panic:
+                voiceManager.resetAllVoices(); // [Fidelidad] Deep Reset
+                mainChorus.reset();
+                for (auto& part : parts) {
+                    part->busHpf.reset();
+                    if (part->chorus != nullptr) part->chorus->reset();
+                }
+                performanceState.noteOffFifo.reset();
+                performanceState.noteOffBuffer.fill(0);
+                hostNotes.clear();
+                midiOutBuffer.addEvent(juce::MidiMessage::allNotesOff(1), 0);
+                break;
+            case JunoEventQueue::Event::Type::ForceUpdate: pendingForceUpdate = true; break;
+        }
+    });
+}
 
 SynthParams SimpleJuno106AudioProcessor::getMirrorParameters() {
     SynthParams p;
@@ -456,6 +885,7 @@ SynthParams SimpleJuno106AudioProcessor::getMirrorParameters() {
     p.noiseLevel = fmtNoise->load(); 
     p.lfoToDCO = fmtLfoToDCO->load(); 
     p.hpfFreq = (int)fmtHpfFreq->load();
+    p.busHpf = fmtBusHpf->load() > 0.5f;
     p.vcfFreq = fmtVcfFreq->load(); 
     p.resonance = fmtResonance->load(); 
     p.envAmount = fmtEnvAmount->load();
@@ -490,6 +920,7 @@ SynthParams SimpleJuno106AudioProcessor::getMirrorParameters() {
 void SimpleJuno106AudioProcessor::updateParamsFromAPVTS() {
     currentParams = getMirrorParameters();
     lastParams = currentParams;
+    markParametersDirty(SynthParamDirty::All); // Callers push to the voices directly; re-mirror next block too
 }
 
 
@@ -502,6 +933,30 @@ void SimpleJuno106AudioProcessor::applyPerformanceModulations(SynthParams& p) {
 void SimpleJuno106AudioProcessor::sendPatchDump() { sendSysEx(sysExEngine.makePatchDump(midiChannel - 1, currentParams)); }
 void SimpleJuno106AudioProcessor::sendManualMode() { sendSysEx(JunoSysEx::createManualMode(midiChannel - 1)); }
 
+void SimpleJuno106AudioProcessor::renderMasterLfo(int numSamples, float phaseIncrement, float delayIncrement, bool anyHeld) {
+    numSamples = juce::jmin(numSamples, (int)lfoBuffer.size());
+    renderLfo(lfoBuffer.data(), numSamples, masterLfoPhase, masterLfoDelayEnvelope, phaseIncrement, delayIncrement, anyHeld);
+}
+
+void SimpleJuno106AudioProcessor::renderLfo(float* out, int numSamples, float& phase, float& delayEnvelope,
+                                            float phaseIncrement, float delayIncrement, bool anyHeld) {
+    for (int i = 0; i < numSamples; ++i) {
+        phase += phaseIncrement;
+        if (phase >= 1.0f) phase -= 1.0f;
+        
+        if (anyHeld) {
+            delayEnvelope += delayIncrement;
+            if (delayEnvelope > 1.0f) delayEnvelope = 1.0f;
+        } else {
+            delayEnvelope = 0.0f;
+        }
+
+        float lfoTri = 2.0f * std::abs(2.0f * (phase - 0.5f)) - 1.0f;
+        float lfoTriStepped = std::floor(lfoTri * 15.99f) / 15.0f; 
+        out[i] = lfoTriStepped * delayEnvelope;
+    }
+}
+
 juce::MidiMessage SimpleJuno106AudioProcessor::getCurrentSysExData() { 
     // [Fix] Live feedback: regenerate dump from current parameters cached from APVTS
     // This ensures the HEX display updates as the user moves controls.
@@ -509,12 +964,7 @@ juce::MidiMessage SimpleJuno106AudioProcessor::getCurrentSysExData() {
     return sysExEngine.makePatchDump(midiChannel - 1, p); 
 }
 void SimpleJuno106AudioProcessor::triggerPanic() {
-    voiceManager.resetAllVoices(); // [Fidelidad] Deep Reset
-    chorus.reset();
-    chorus2.reset();
-    performanceState.noteOffFifo.reset(); 
-    performanceState.noteOffBuffer.fill(0); 
-    midiOutBuffer.addEvent(juce::MidiMessage::allNotesOff(1), 0);
+    uiEvents.postPanic(); // Reset runs at the start of the next block (drainUiEvents)
 }
 
 void SimpleJuno106AudioProcessor::loadPreset(int index) {
@@ -537,11 +987,8 @@ void SimpleJuno106AudioProcessor::loadPreset(int index) {
             
             // [Fix] Explicitly update local params for non-audio purposes (SysEx, etc)
             // And force voiceManager update
-            updateParamsFromAPVTS(); 
-            voiceManager.updateParams(currentParams);
-            voiceManager.forceUpdate(); // Essential for VCF smoothing reset
-            
-            voiceManager.forceUpdate(); // Essential for VCF smoothing reset
+            updateParamsFromAPVTS(); // Marks every group dirty for the next block
+            uiEvents.postForceUpdate(); // Essential for VCF smoothing reset
         }
     }
 }
@@ -562,6 +1009,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout SimpleJuno106AudioProcessor:
     params.push_back(makeParam("noise", "Noise Level", 0.0f, 1.0f, 0.0f));
     params.push_back(makeParam("lfoToDCO", "LFO to DCO", 0.0f, 1.0f, 0.0f));
     params.push_back(makeIntParam("hpfFreq", "HPF Freq", 0, 3, 0));
+    params.push_back(makeBool("busHpf", "Authentic Bus HPF", true));
     params.push_back(makeParam("vcfFreq", "VCF Freq", 0.0f, 1.0f, 1.0f));
     params.push_back(makeParam("resonance", "Resonance", 0.0f, 1.0f, 0.0f));
     params.push_back(makeParam("envAmount", "Env Amount", 0.0f, 1.0f, 0.0f));
@@ -598,17 +1046,58 @@ juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter() {
 }
 bool SimpleJuno106AudioProcessor::hasEditor() const { 
     DBG("SimpleJuno106AudioProcessor::hasEditor() query");
+   #if JUCE_HEADLESS_PLUGIN
+    return false;
+   #else
     return true; 
+   #endif
 }
 juce::AudioProcessorEditor* SimpleJuno106AudioProcessor::createEditor() { 
+   #if JUCE_HEADLESS_PLUGIN
+    return nullptr; // [Headless] No UI sources are compiled in
+   #else
     DBG("SimpleJuno106AudioProcessor::createEditor() START");
     auto* e = new SimpleJuno106AudioProcessorEditor (*this); 
     DBG("SimpleJuno106AudioProcessor::createEditor() END");
     return e;
+   #endif
+}
+
+namespace
+{
+    // [Multitimbral] Part patches in the plugin state: one PART child per part, properties keyed by parameter ID
+    juce::ValueTree partPatchToTree(const SynthParams& patch, int index) {
+        juce::ValueTree tree("PART");
+        tree.setProperty("index", index, nullptr);
+        SynthParamFields::forEach([&tree](const char* id, juce::uint32, const auto& value) {
+            tree.setProperty(id, value, nullptr);
+        }, patch);
+        return tree;
+    }
+
+    SynthParams partPatchFromTree(const juce::ValueTree& tree, SynthParams patch) {
+        SynthParamFields::forEach([&tree](const char* id, juce::uint32, auto& value) {
+            using Value = std::decay_t<decltype(value)>;
+            if (tree.hasProperty(id)) value = static_cast<Value>(tree.getProperty(id));
+        }, patch);
+        return patch;
+    }
 }
 
 void SimpleJuno106AudioProcessor::getStateInformation(juce::MemoryBlock& destData) {
     auto state = apvts.copyState();
+
+    // The panel only holds the edit part: save the layout and every part's patch alongside it
+    juce::ValueTree layout("PARTS");
+    layout.setProperty("numParts", getNumParts(), nullptr);
+    layout.setProperty("chorusRouting", chorusRouting == ChorusRouting::PerPart ? "perPart" : "shared", nullptr);
+    {
+        const juce::SpinLock::ScopedLockType lock(partSnapshotLock);
+        for (size_t p = 0; p < partSnapshot.size(); ++p)
+            layout.appendChild(partPatchToTree(partSnapshot[p], (int)p), nullptr);
+    }
+    state.appendChild(layout, nullptr);
+
     std::unique_ptr<juce::XmlElement> xml(state.createXml());
     copyXmlToBinary(*xml, destData);
 }
@@ -616,10 +1105,41 @@ void SimpleJuno106AudioProcessor::setStateInformation(const void* data, int size
     DBG("SimpleJuno106AudioProcessor::setStateInformation START (" + juce::String(sizeInBytes) + " bytes)");
     std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
     if (xmlState != nullptr) if (xmlState->hasTagName(apvts.state.getType())) {
-        apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
+        auto state = juce::ValueTree::fromXml(*xmlState);
+        auto layout = state.getChildWithName("PARTS");
+        state.removeChild(layout, nullptr); // Not part of the APVTS state
+        // [Compat] Sessions saved before the bus HPF existed keep the per-voice filters
+        if (! state.getChildWithProperty("id", "busHpf").isValid()) {
+            juce::ValueTree legacyHpf("PARAM");
+            legacyHpf.setProperty("id", "busHpf", nullptr);
+            legacyHpf.setProperty("value", 0.0f, nullptr);
+            state.appendChild(legacyHpf, nullptr);
+        }
+        apvts.replaceState(state);
         updateParamsFromAPVTS();
-        voiceManager.updateParams(currentParams);
-        voiceManager.forceUpdate();
+        if (layout.isValid()) restorePartLayout(layout);
+        uiEvents.postForceUpdate();
     }
     DBG("SimpleJuno106AudioProcessor::setStateInformation END");
 }
+
+void SimpleJuno106AudioProcessor::restorePartLayout(const juce::ValueTree& layout) {
+    const int numParts = juce::jlimit(1, kMaxParts, (int)layout.getProperty("numParts", 1));
+    const auto routing = layout.getProperty("chorusRouting").toString() == "perPart" ? ChorusRouting::PerPart : ChorusRouting::Shared;
+
+    if (numParts != getNumParts() || (numParts > 1 && routing != chorusRouting)) {
+        // Parts allocate: hold the audio callback off while they are rebuilt and prepared
+        suspendProcessing(true);
+        setMultitimbral(numParts, routing);
+        if (getSampleRate() > 0.0) prepareToPlay(getSampleRate(), getBlockSize());
+        suspendProcessing(false);
+    }
+
+    // Patches reach the audio thread through the part-patch queue, as setPartPatch from the UI
+    const SynthParams panel = getMirrorParameters(); // Fields missing from older states
+    for (const auto& partTree : layout) {
+        const int index = partTree.getProperty("index", -1);
+        if (juce::isPositiveAndBelow(index, (int)parts.size()))
+            setPartPatch(index + 1, partPatchFromTree(partTree, panel));
+    }
+}
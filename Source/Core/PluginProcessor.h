@@ -4,20 +4,36 @@
 #include <atomic>
 #include <cmath>
 #include <algorithm>
+#include <limits>
+#include <bitset>
 #include "../Synth/Voice.h"
 #include "JunoVoiceManager.h"
 #include "JunoSysEx.h"
 #include "MidiLearnHandler.h"
 #include "JunoSysExEngine.h"
 #include "PerformanceState.h"
-#include "JunoBBD.h" // [Correct Placement]
+#include "JunoChorus.h"
+#include "JunoSilenceTracker.h"
+#include "JunoEventQueue.h"
+#include "../Synth/JunoBusHPF.h"
+
+#ifndef JUNO_MULTITIMBRAL_PARTS
+ #define JUNO_MULTITIMBRAL_PARTS 1
+#endif
+
+#ifndef JUNO_PER_PART_CHORUS
+ #define JUNO_PER_PART_CHORUS 0
+#endif
 
 class PresetManager;
 
 class SimpleJuno106AudioProcessor : public juce::AudioProcessor,
-                                     public juce::MidiKeyboardState::Listener {
+                                     public juce::MidiKeyboardState::Listener,
+                                     private juce::AudioProcessorParameter::Listener,
+                                     private juce::Timer {
 public:
-    SimpleJuno106AudioProcessor();
+    /** voicePoolSize: voices the engine holds (1..JunoVoiceManager::kMaxPoolSize); tools pass their --pool / --voices flag. */
+    explicit SimpleJuno106AudioProcessor(int voicePoolSize = JUNO_VOICE_POOL_SIZE);
     ~SimpleJuno106AudioProcessor() override;
 
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
@@ -50,13 +66,36 @@ public:
     void getStateInformation(juce::MemoryBlock& destData) override;
     void setStateInformation(const void* data, int sizeInBytes) override;
     
+    // [Optimization] All DSP runs in chunks of at most kRenderChunk samples whatever the host block:
+    // scratch stays in L1, is sized once at construction and the cost per sample is host-independent
+    static constexpr int kRenderChunk = 32;
+
+    // Multitimbral mode: MIDI channel n plays part n - 1 with its own patch, LFO and bus HPF; every
+    // part draws from the one voice pool. The panel (APVTS) edits the part on midiChannel and is
+    // inert while no part listens there. Layout and part patches are saved with the plugin state.
+    enum class ChorusRouting { Shared, PerPart }; // Shared: one chorus after the part mix, switched from the panel
+    static constexpr int kMaxParts = JunoVoiceManager::kMaxParts;
+
+    /** 1 = single-timbral. voicesPerPart sets the voice limit to numParts x voicesPerPart within the pool
+        (0 = the whole pool). Allocates: message thread, before prepareToPlay (like JunoVoiceManager::setPoolSize). */
+    void setMultitimbral(int numParts, ChorusRouting routing = ChorusRouting::Shared, int voicesPerPart = 0);
+    int getNumParts() const { return voiceManager.getNumParts(); }
+    ChorusRouting getChorusRouting() const { return chorusRouting; }
+
+    /** Message thread: replaces the patch of the part on midiChannel (posted to the audio thread). */
+    void setPartPatch(int midiChannel, const SynthParams& patch);
+    /** Message thread (processor timer; offline tools call it between blocks): loads the panel with
+        the edit part's patch after the audio thread asked for it (edit channel switch, part patch). */
+    void syncPanelToEditPart();
+
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
     class PresetManager* getPresetManager();
     const JunoVoiceManager& getVoiceManager() const { return voiceManager; }
     JunoVoiceManager& getVoiceManagerNC() { return voiceManager; } 
     MidiLearnHandler& getMidiLearnHandler() { return midiLearnHandler; }
     
-    juce::MidiKeyboardState keyboardState;
+    juce::MidiKeyboardState keyboardState; // Message thread only (on-screen keyboards)
+    void syncKeyboardDisplay(); // Message thread (editor timer): shows the held host notes on keyboardState
 
     void loadPreset(int index);
     void updateParamsFromAPVTS();
@@ -64,14 +103,19 @@ public:
     void applyPerformanceModulations(SynthParams& p);
     void sendPatchDump();
     void sendManualMode(); 
-    void triggerPanic();
+    void triggerPanic(); // Message thread: posted to the audio thread (JunoEventQueue)
+    void renderMasterLfo(int numSamples, float phaseIncrement, float delayIncrement, bool anyHeld); // Fills lfoBuffer (also driven by JunoBenchmark)
     void setSustainPolarity(bool inverted) { sustainInverted = inverted; }
 
     SynthParams getMirrorParameters(); // [Fidelidad] Block-consistent mirror
 
-    float getChorusLfoPhase(int mode) const { 
-        return (mode == 1) ? chorusLfoPhaseI : chorusLfoPhaseII; 
-    }
+    /** Bumped by every parameter change; processBlock only re-mirrors when it moved. */
+    juce::uint32 getParameterVersion() const { return paramVersion.load(std::memory_order_acquire); }
+
+    /** True while the instance is idle and processBlock only outputs silence (see JunoSilenceTracker). */
+    bool isSilent() const { return silenceTracker.isSilent(); }
+
+    float getChorusLfoPhase(int mode) const { return mainChorus.getLfoPhase(mode); }
 
     bool isTestMode = false;
     void triggerTestProgram(int bankIndex);
@@ -100,6 +144,21 @@ private:
     SynthParams currentParams;
     SynthParams lastParams;
 
+    // [Optimization] Versioned parameter snapshot: the listener bumps paramVersion and ORs the
+    // SynthParamDirty groups; processBlock re-reads the APVTS only when the version moved and
+    // voices rebuild only the dirty groups
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+    void parameterGestureChanged(int, bool) override {}
+    void markParametersDirty(juce::uint32 groups);
+    juce::uint32 consumeParameterChanges();
+
+    std::vector<juce::uint32> parameterDirtyBits; // Indexed like getParameters()
+    std::atomic<juce::uint32> paramDirtyMask { SynthParamDirty::All };
+    std::atomic<juce::uint32> paramVersion { 1 };
+    juce::uint32 seenParamVersion = 0;
+    SynthParams mirroredParams;      // Raw APVTS snapshot; currentParams adds the per-block modulations
+    float appliedVoiceBender = 0.0f; // Last bender pushed to the voices
+
     std::unique_ptr<class PresetManager> presetManager;
     
     JunoSysExEngine sysExEngine;
@@ -114,26 +173,70 @@ private:
         lastSysExMessage = msg;
     }
 
-    // [Fidelidad] Authentic MN3009 BBD Emulation
-    JunoDSP::JunoBBD chorus; 
-    JunoDSP::JunoBBD chorus2; // Mode II / Dual line
-    juce::Random chorusNoiseGen; 
+    JunoChorus mainChorus; // [Fidelidad] MN3009 chorus section (pre-emphasis, two BBD lines, hiss)
+    juce::Random thermalNoiseGen;
     
     juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>> dcBlocker; 
     
-    // [VCA/Chorus Audit] Filters for authentic chorus emulation
-    juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>> chorusPreEmphasisFilter;
+    // [VCA/Chorus Audit] De-emphasis runs once over the output, after every chorus
     juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>> chorusDeEmphasisFilter;
-    juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>> chorusNoiseFilter;
-    juce::AudioBuffer<float> chorusNoiseBuffer;
+
+    JunoBusHPF busHpf; // [Fidelidad] HPF after the voice sum (SynthParams::busHpf)
+
+    // [Optimization] Multitimbral parts: one instance and one voice pool instead of a plugin per part
+    struct Part {
+        SynthParams patch;                         // Panel values (edit part: panel edits copied in per dirty group)
+        SynthParams params;                        // patch + performance modulations, as pushed to the voices
+        juce::uint32 dirty = SynthParamDirty::All; // Groups not yet pushed to the part's voices
+        float appliedBender = 0.0f;
+        float lfoPhase = 0.0f;
+        float lfoDelayEnvelope = 0.0f;
+        bool wasAnyNoteHeld = false;
+        std::vector<float> lfo, bus;               // One chunk each
+        JunoBusHPF busHpf;
+        std::unique_ptr<JunoChorus> chorus;        // ChorusRouting::PerPart only
+    };
+    struct PartPatchEvent { int part = 0; SynthParams patch; };
+
+    bool isMultitimbral() const { return !parts.empty(); }
+    static void renderLfo(float* out, int numSamples, float& phase, float& delayEnvelope, float phaseIncrement, float delayIncrement, bool anyHeld);
+    int getEditPart() const { return voiceManager.partForChannel(midiChannel); } // -1: no part on midiChannel (panel inert)
+    bool handlePartMidiEvent(const juce::MidiMessage& message); // Channel messages for a part other than the edit part
+    void applyPartChanges(juce::uint32 panelDirty);
+    void loadPatchIntoPanel(const SynthParams& patch); // Message thread: the APVTS shows the edit part
+    void timerCallback() override { syncPanelToEditPart(); }
+    void restorePartLayout(const juce::ValueTree& layout); // setStateInformation: layout + part patches
+    float renderPartsChunk(float* outL, float* outR, int numSamples, float masterVol, bool& chorusUsed); // Returns the bus peak
+
+    std::vector<std::unique_ptr<Part>> parts; // Empty when single-timbral
+    ChorusRouting chorusRouting = ChorusRouting::Shared;
+    JunoMpscQueue<PartPatchEvent, 32> partPatches; // UI and setStateInformation (any host thread)
+    int panelPart = -1;                            // Audio thread: part the APVTS currently shows
+    bool panelLoadRequested = false;               // Audio thread: panel load waiting for the snapshot publish
+    std::atomic<int> panelLoadPart { -1 };         // Part whose patch the message thread loads into the panel
+    std::vector<juce::RangedAudioParameter*> panelFieldParams; // SynthParamFields order, resolved once
+    std::vector<SynthParams> partSnapshot;         // Part patches for getStateInformation (under partSnapshotLock)
+    juce::SpinLock partSnapshotLock;               // Audio thread only ever try-locks it
+    bool partSnapshotStale = false;                // Audio thread: last publish found the lock taken
+    juce::AudioBuffer<float> partOutBuffer; // Per-part chorus output, one chunk
+
+    // [Fidelidad] Sample-accurate MIDI: processBlock splits at event timestamps, never below kMinSubBlock
+    static constexpr int kMinSubBlock = 8;
+    void handleMidiEvent(const juce::MidiMessage& message);
+    juce::uint32 applyParameterChanges(); // Mirrors the APVTS into currentParams and the voices; returns the dirty groups
+    void flushMidiOut(juce::MidiBuffer& midiMessages); // Panel SysEx + midiOutBuffer, once input events are consumed
+
+    // [Safety] UI -> audio commands; voiceManager is only touched from processBlock
+    void drainUiEvents();
+    JunoEventQueue uiEvents;
+    JunoHeldNotes hostNotes;              // Audio -> UI: host notes for the keyboard display
+    std::bitset<128> displayedHostNotes;  // Message thread: what syncKeyboardDisplay last showed
+    bool mirroringHostNotes = false;      // Message thread: keyboardState changes made by syncKeyboardDisplay
+    bool pendingForceUpdate = false;
 
     float masterLfoPhase = 0.0f;
     float masterLfoDelayEnvelope = 0.0f;
     
-    // [Fidelidad] Chorus LFOs para Leakage y LED
-    float chorusLfoPhaseI = 0.0f;
-    float chorusLfoPhaseII = 0.0f;
-    
     float currentPowerSag = 0.0f;
     float chorusFade = 0.0f;
 
@@ -142,10 +245,15 @@ private:
     
     double warmUpTime = 0.0;
     float globalDriftAudible = 0.0f;
-    int thermalCounter = 0;
+    void advanceThermalDrift(int numSamples);
+    int thermalCounter = 0; // Samples since the last drift target
+    int driftPushCounter = 0; // Samples since the drift last reached the voices
+    bool driftPushDue = true;
     float thermalTarget = 0.0f;
 
     std::vector<float> lfoBuffer;
+    std::vector<float> voiceBus; // Mono sum of all voices, one chunk
+    JunoSilenceTracker silenceTracker;
 
     // [Optimization] Cached Parameter Pointers (Audio Thread Safe)
     std::atomic<float>* fmtDcoRange = nullptr;
@@ -157,6 +265,7 @@ private:
     std::atomic<float>* fmtNoise = nullptr;
     std::atomic<float>* fmtLfoToDCO = nullptr;
     std::atomic<float>* fmtHpfFreq = nullptr;
+    std::atomic<float>* fmtBusHpf = nullptr;
     std::atomic<float>* fmtVcfFreq = nullptr;
     std::atomic<float>* fmtResonance = nullptr;
     std::atomic<float>* fmtEnvAmount = nullptr;
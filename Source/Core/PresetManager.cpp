@@ -40,6 +40,48 @@ juce::Result PresetManager::loadTape(const juce::File& wavFile) {
     return juce::Result::ok();
 }
 
+void PresetManager::addLibraryFromSysEx(const uint8_t* data, int size) {
+    // Juno-106 patch dump: F0 41 30 ch [18 bytes] F7
+    addLibrary("SysEx");
+    int libIdx = getNumLibraries() - 1;
+    for (int i = 0; i < getNumLibraries(); ++i) if (libraries[i].name == "SysEx") libIdx = i;
+    libraries[libIdx].patches.clear();
+
+    for (int i = 0; i + 22 < size; ++i) {
+        if (data[i] == 0xF0 && data[i+1] == 0x41 && data[i+2] == 0x30) {
+            int n = (int)libraries[libIdx].patches.size() + 1;
+            libraries[libIdx].patches.push_back(createPresetFromJunoBytes(juce::String(n).paddedLeft('0', 2), data + i + 4));
+            i += 22; // Skip to F7
+        }
+    }
+    selectLibrary(libIdx);
+}
+
+juce::Result PresetManager::addLibraryFromJson(const juce::File& file) {
+    auto json = juce::JSON::parse(file);
+    auto* obj = json.getDynamicObject();
+    if (obj == nullptr) return juce::Result::fail("Invalid JSON");
+
+    Library lib;
+    lib.name = file.getFileNameWithoutExtension();
+    auto addPreset = [&lib](const juce::var& v) {
+        if (auto* o = v.getDynamicObject(); o != nullptr && o->hasProperty("state"))
+            lib.patches.push_back(Preset(o->getProperty("name").toString(), lib.name, juce::ValueTree::fromXml(o->getProperty("state").toString())));
+    };
+
+    if (obj->hasProperty("presets")) { // exportLibraryToJson format
+        if (auto* arr = obj->getProperty("presets").getArray())
+            for (const auto& v : *arr) addPreset(v);
+    } else {
+        addPreset(json); // saveUserPreset format
+    }
+    if (lib.patches.empty()) return juce::Result::fail("No patches");
+
+    libraries.push_back(lib);
+    selectLibrary(getNumLibraries() - 1);
+    return juce::Result::ok();
+}
+
 // Overload for the authentic struct
 PresetManager::Preset PresetManager::createPresetFromJunoPatch(const JunoPatch& p) {
     juce::ValueTree state("Parameters");
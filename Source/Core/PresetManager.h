@@ -44,6 +44,7 @@ public:
 
     // [Refactored] Generic File Import
     void addLibraryFromSysEx(const uint8_t* data, int size);
+    juce::Result addLibraryFromJson(const juce::File& file); // Single preset or exported library
     juce::Result importPresetsFromFile(const juce::File& file);
     
     // [reimplement.md] Export features
@@ -0,0 +1,161 @@
+// Source/Core/RealtimeSentinel.cpp
+#include "RealtimeSentinel.h"
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if JUNO_RT_SENTINEL && JUCE_LINUX
+ #include <dlfcn.h>
+ #include <pthread.h>
+#endif
+
+namespace JunoRT
+{
+    namespace
+    {
+        thread_local int realtimeDepth = 0;
+        thread_local int exemptDepth = 0;
+        thread_local bool reporting = false; // Reporting allocates: don't trap ourselves
+
+        std::array<std::atomic<int>, (size_t)Violation::NumKinds> counts {};
+    }
+
+    ScopedRealtimeSection::ScopedRealtimeSection() noexcept { ++realtimeDepth; }
+    ScopedRealtimeSection::~ScopedRealtimeSection() noexcept { --realtimeDepth; }
+
+    ScopedRealtimeExemption::ScopedRealtimeExemption() noexcept { ++exemptDepth; }
+    ScopedRealtimeExemption::~ScopedRealtimeExemption() noexcept { --exemptDepth; }
+
+    bool isInRealtimeSection() noexcept {
+        return realtimeDepth > 0 && exemptDepth == 0 && !reporting;
+    }
+
+    const char* getViolationName(Violation kind) noexcept {
+        switch (kind) {
+            case Violation::HeapAllocation: return "heap allocation";
+            case Violation::HeapFree:       return "heap free";
+            case Violation::LockAcquire:    return "lock acquire";
+            default:                        return "unknown";
+        }
+    }
+
+    void reportViolation(Violation kind) noexcept {
+        const int n = ++counts[(size_t)kind];
+
+        reporting = true;
+        std::fprintf(stderr, "[RT Sentinel] %s on realtime thread (#%d)\n", getViolationName(kind), n);
+       #if JUNO_RT_SENTINEL
+        try {
+            std::fputs(juce::SystemStats::getStackBacktrace().toRawUTF8(), stderr);
+        } catch (...) {}
+       #endif
+        std::fflush(stderr);
+        reporting = false;
+    }
+
+    int getViolationCount(Violation kind) noexcept { return counts[(size_t)kind].load(); }
+
+    int getViolationCount() noexcept {
+        int total = 0;
+        for (auto& c : counts) total += c.load();
+        return total;
+    }
+
+    void resetViolationCounts() noexcept {
+        for (auto& c : counts) c.store(0);
+    }
+}
+
+#if JUNO_RT_SENTINEL
+//==============================================================================
+// Global allocation hooks. Only compiled into sentinel builds.
+namespace
+{
+    void* checkedAlloc(std::size_t size) {
+        if (JunoRT::isInRealtimeSection()) JunoRT::reportViolation(JunoRT::Violation::HeapAllocation);
+        if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+        throw std::bad_alloc();
+    }
+
+    void checkedFree(void* p) noexcept {
+        if (p == nullptr) return;
+        if (JunoRT::isInRealtimeSection()) JunoRT::reportViolation(JunoRT::Violation::HeapFree);
+        std::free(p);
+    }
+
+    // C++17 over-aligned types (alignas above the default new alignment)
+    void* checkedAlignedAlloc(std::size_t size, std::align_val_t align) {
+        if (JunoRT::isInRealtimeSection()) JunoRT::reportViolation(JunoRT::Violation::HeapAllocation);
+        const std::size_t alignment = juce::jmax((std::size_t)align, sizeof(void*));
+        if (size == 0) size = 1;
+       #if JUCE_WINDOWS
+        if (void* p = _aligned_malloc(size, alignment)) return p;
+       #else
+        void* p = nullptr;
+        if (posix_memalign(&p, alignment, size) == 0) return p;
+       #endif
+        throw std::bad_alloc();
+    }
+
+    void checkedAlignedFree(void* p) noexcept {
+        if (p == nullptr) return;
+        if (JunoRT::isInRealtimeSection()) JunoRT::reportViolation(JunoRT::Violation::HeapFree);
+       #if JUCE_WINDOWS
+        _aligned_free(p);
+       #else
+        std::free(p);
+       #endif
+    }
+}
+
+void* operator new(std::size_t size) { return checkedAlloc(size); }
+void* operator new[](std::size_t size) { return checkedAlloc(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { try { return checkedAlloc(size); } catch (...) { return nullptr; } }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { try { return checkedAlloc(size); } catch (...) { return nullptr; } }
+
+void operator delete(void* p) noexcept { checkedFree(p); }
+void operator delete[](void* p) noexcept { checkedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { checkedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { checkedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { checkedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { checkedFree(p); }
+
+void* operator new(std::size_t size, std::align_val_t a) { return checkedAlignedAlloc(size, a); }
+void* operator new[](std::size_t size, std::align_val_t a) { return checkedAlignedAlloc(size, a); }
+void* operator new(std::size_t size, std::align_val_t a, const std::nothrow_t&) noexcept { try { return checkedAlignedAlloc(size, a); } catch (...) { return nullptr; } }
+void* operator new[](std::size_t size, std::align_val_t a, const std::nothrow_t&) noexcept { try { return checkedAlignedAlloc(size, a); } catch (...) { return nullptr; } }
+
+void operator delete(void* p, std::align_val_t) noexcept { checkedAlignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { checkedAlignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { checkedAlignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { checkedAlignedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { checkedAlignedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { checkedAlignedFree(p); }
+
+#if JUCE_LINUX
+//==============================================================================
+// Lock hook: interposes pthread_mutex_lock for the whole executable, so locks inside
+// JUCE (CriticalSection, MidiKeyboardState, MessageManager) and std::mutex are seen too.
+namespace
+{
+    using MutexLockFn = int (*)(pthread_mutex_t*);
+    std::atomic<MutexLockFn> realMutexLock { nullptr };
+
+    MutexLockFn getRealMutexLock() noexcept {
+        MutexLockFn fn = realMutexLock.load(std::memory_order_acquire);
+        if (fn == nullptr) {
+            fn = reinterpret_cast<MutexLockFn>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+            realMutexLock.store(fn, std::memory_order_release);
+        }
+        return fn;
+    }
+}
+
+extern "C" int pthread_mutex_lock(pthread_mutex_t* mutex) {
+    if (JunoRT::isInRealtimeSection()) JunoRT::reportViolation(JunoRT::Violation::LockAcquire);
+    return getRealMutexLock()(mutex);
+}
+#endif
+#endif
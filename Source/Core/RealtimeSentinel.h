@@ -0,0 +1,80 @@
+// Source/Core/RealtimeSentinel.h
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef JUNO_RT_SENTINEL
+ #define JUNO_RT_SENTINEL 0
+#endif
+
+/**
+ * RealtimeSentinel - Opt-in realtime-safety instrumentation (JUNO_RT_SENTINEL=1)
+ *
+ * While a thread is inside a realtime section (processBlock), the sentinel traps:
+ * - Global operator new / delete, aligned forms included (heap allocation or release).
+ * - Locks: on Linux every pthread_mutex_lock is interposed, which covers
+ *   juce::CriticalSection, std::mutex and library-internal locks such as
+ *   juce::MidiKeyboardState's. Interposition only takes effect in executables
+ *   (Standalone, JunoRtCheck, the tools), not in a plugin loaded by a host.
+ *   Elsewhere only JunoRT::CriticalSection is checked. juce::SpinLock never
+ *   reaches the OS and is not trapped.
+ *
+ * Every violation is counted per kind and printed to stderr with a stack trace.
+ * With the flag off, the section macro is empty and JunoRT::CriticalSection is
+ * a plain juce::CriticalSection: zero cost in release builds.
+ */
+namespace JunoRT
+{
+    enum class Violation { HeapAllocation, HeapFree, LockAcquire, NumKinds };
+
+    /** Marks the calling thread as realtime for the lifetime of the object. Nestable. */
+    struct ScopedRealtimeSection {
+        ScopedRealtimeSection() noexcept;
+        ~ScopedRealtimeSection() noexcept;
+        JUCE_DECLARE_NON_COPYABLE(ScopedRealtimeSection)
+    };
+
+    /** Temporarily allows violations (e.g. a known, accepted allocation). */
+    struct ScopedRealtimeExemption {
+        ScopedRealtimeExemption() noexcept;
+        ~ScopedRealtimeExemption() noexcept;
+        JUCE_DECLARE_NON_COPYABLE(ScopedRealtimeExemption)
+    };
+
+    bool isInRealtimeSection() noexcept;
+    void reportViolation(Violation kind) noexcept;
+
+    int getViolationCount() noexcept;
+    int getViolationCount(Violation kind) noexcept;
+    void resetViolationCounts() noexcept;
+    const char* getViolationName(Violation kind) noexcept;
+
+    /** juce::CriticalSection that reports when entered from a realtime section. */
+    class CheckedCriticalSection {
+    public:
+        void enter() const noexcept { check(); cs.enter(); }
+        bool tryEnter() const noexcept { check(); return cs.tryEnter(); }
+        void exit() const noexcept { cs.exit(); }
+
+        using ScopedLockType = juce::GenericScopedLock<CheckedCriticalSection>;
+
+    private:
+        static void check() noexcept { if (isInRealtimeSection()) reportViolation(Violation::LockAcquire); }
+        juce::CriticalSection cs;
+    };
+
+   #if JUNO_RT_SENTINEL && !JUCE_LINUX
+    using CriticalSection = CheckedCriticalSection; // Linux: the pthread_mutex_lock hook already reports
+   #else
+    using CriticalSection = juce::CriticalSection;
+   #endif
+    using ScopedLock = juce::GenericScopedLock<CriticalSection>;
+}
+
+#if JUNO_RT_SENTINEL
+ #define JUNO_RT_SECTION  const JunoRT::ScopedRealtimeSection junoRealtimeSection;
+ #define JUNO_RT_EXEMPT   const JunoRT::ScopedRealtimeExemption junoRealtimeExemption;
+#else
+ #define JUNO_RT_SECTION
+ #define JUNO_RT_EXEMPT
+#endif
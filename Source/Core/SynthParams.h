@@ -42,6 +42,7 @@ struct SynthParams {
     float benderToLFO = 0.0f;   
     
     float thermalDrift = 0.0f; // [Senior Audit] Global drift
+    float bendCV() const { return benderValue + thermalDrift; } // The shared DAC drift rides on the bender CV
     float tune = 0.5f;          
     int midiChannel = 1;        // [Added for SysEx]
     
@@ -51,6 +52,7 @@ struct SynthParams {
     int vcfPolarity = 0;           
     
     int hpfFreq = 0;               
+    bool busHpf = true;            // HPF on the summed bus (false: legacy per-voice filters)
     
     bool portamentoOn = false;     
     bool portamentoLegato = false; 
@@ -58,6 +60,102 @@ struct SynthParams {
     bool midiOut = false;          // [Added] Sync for SysEx
 };
 
+/**
+ * SynthParamDirty - Dirty bits for SynthParams, one per group of fields sharing derived state
+ *
+ * The processor's parameter listener ORs these in; voices only rebuild what a set bit
+ * covers (ADSR rates, DCO settings, HPF coefficients...), so untouched knobs cost nothing.
+ */
+namespace SynthParamDirty
+{
+    enum : juce::uint32 {
+        Dco         = 1u << 0,  // Range, waveforms, PWM, sub, noise, LFO->DCO
+        Vcf         = 1u << 1,  // Cutoff, resonance, env amount, LFO->VCF, kybd, polarity
+        Envelope    = 1u << 2,  // A/D/S/R, VCA mode
+        Vca         = 1u << 3,  // VCA level
+        Hpf         = 1u << 4,
+        Lfo         = 1u << 5,  // Rate, delay (processor only)
+        Chorus      = 1u << 6,  // Processor only
+        Performance = 1u << 7,  // Bender, tune, portamento, poly mode
+        Thermal     = 1u << 8,  // Global drift (between edits it goes through setThermalDrift every 512 samples)
+        System      = 1u << 9,  // MIDI out / channel
+        All         = 0xffffffffu
+    };
+}
+
+/**
+ * SynthParamFields - The SynthParams fields the panel (APVTS) mirrors, keyed by parameter ID
+ *
+ * forEach(fn, a, b...) calls fn(id, groups, a.field, b.field...) once per field, where groups
+ * are the field's dirty bits. It is the single field -> group table: the parameter listener
+ * (SynthParamDirty::forParameterID) reads it too. Multitimbral parts use it to copy panel
+ * edits per group, load a part into the panel and save part patches.
+ */
+namespace SynthParamFields
+{
+    template <typename Fn, typename... Params>
+    void forEach(Fn&& fn, Params&... p) {
+        using namespace SynthParamDirty;
+        fn("dcoRange", Dco, p.dcoRange...);
+        fn("sawOn", Dco, p.sawOn...);
+        fn("pulseOn", Dco, p.pulseOn...);
+        fn("pwm", Dco, p.pwmAmount...);
+        fn("pwmMode", Dco, p.pwmMode...);
+        fn("subOsc", Dco, p.subOscLevel...);
+        fn("noise", Dco, p.noiseLevel...);
+        fn("lfoToDCO", Dco, p.lfoToDCO...);
+        fn("vcfFreq", Vcf, p.vcfFreq...);
+        fn("resonance", Vcf, p.resonance...);
+        fn("envAmount", Vcf, p.envAmount...);
+        fn("vcfPolarity", Vcf, p.vcfPolarity...);
+        fn("kybdTracking", Vcf, p.kybdTracking...);
+        fn("lfoToVCF", Vcf, p.lfoToVCF...);
+        fn("attack", Envelope, p.attack...);
+        fn("decay", Envelope, p.decay...);
+        fn("sustain", Envelope, p.sustain...);
+        fn("release", Envelope, p.release...);
+        fn("vcaMode", Envelope | Vca, p.vcaMode...);
+        fn("vcaLevel", Vca, p.vcaLevel...);
+        fn("hpfFreq", Hpf, p.hpfFreq...);
+        fn("busHpf", Hpf, p.busHpf...);
+        fn("lfoRate", Lfo, p.lfoRate...);
+        fn("lfoDelay", Lfo, p.lfoDelay...);
+        fn("chorus1", Chorus, p.chorus1...);
+        fn("chorus2", Chorus, p.chorus2...);
+        fn("benderToLFO", Performance | Dco | Vcf, p.benderToLFO...);
+        fn("bender", Performance, p.benderValue...);
+        fn("benderToDCO", Performance, p.benderToDCO...);
+        fn("benderToVCF", Performance, p.benderToVCF...);
+        fn("tune", Performance, p.tune...);
+        fn("polyMode", Performance, p.polyMode...);
+        fn("portamentoOn", Performance, p.portamentoOn...);
+        fn("portamentoTime", Performance, p.portamentoTime...);
+        fn("portamentoLegato", Performance, p.portamentoLegato...);
+        fn("midiOut", System, p.midiOut...);
+    }
+
+    /** Copies the fields fed by any of the given dirty groups. */
+    inline void copyGroups(const SynthParams& from, SynthParams& to, juce::uint32 groups) {
+        forEach([groups](const char*, juce::uint32 fieldGroups, const auto& src, auto& dst) {
+            if ((fieldGroups & groups) != 0) dst = src;
+        }, from, to);
+    }
+}
+
+namespace SynthParamDirty
+{
+    /** Group(s) fed by an APVTS parameter. Resolved once, when the listeners are attached. */
+    inline juce::uint32 forParameterID(const juce::String& id) {
+        if (id == "masterVolume") return 0; // Read directly by processBlock
+        juce::uint32 groups = All;          // Unmirrored parameters rebuild everything
+        const SynthParams fields;
+        SynthParamFields::forEach([&id, &groups](const char* fieldID, juce::uint32 fieldGroups, const auto&) {
+            if (id == fieldID) groups = fieldGroups;
+        }, fields);
+        return groups;
+    }
+}
+
 /**
  * [VCA/Chorus Audit] Authentic Juno-106 Chorus Constants (Service Manual Aligned)
  */
@@ -40,6 +40,9 @@ public:
     void setRelease(float seconds);
     void setGateMode(bool enabled);    // ENV button
     
+    // Precomputed MCU-tick coefficients (JunoCurveTables::EnvelopeRates); skips calculateRates()
+    void setRates(float attack, float decay, float release) { attackRate = attack; decayRate = decay; releaseRate = release; }
+    
     // Lifecycle
     void noteOn();
     void noteOff();
@@ -50,6 +53,7 @@ public:
     
     Stage getCurrentStage() const { return stage; }
     float getCurrentValue() const { return currentValue; }
+    float getReleaseRate() const { return releaseRate; } // Per MCU tick multiplier
     
 private:
     double sampleRate = 44100.0;
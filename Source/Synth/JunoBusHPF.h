@@ -0,0 +1,55 @@
+// Source/Synth/JunoBusHPF.h
+#pragma once
+
+#include <JuceHeader.h>
+#include "JunoHPFCoefficients.h"
+
+/**
+ * JunoBusHPF - The 4-position HPF as a single stage on the summed voice bus
+ *
+ * [Fidelidad] On the Juno-106 the HPF sits after the voices are summed, so one
+ * biquad (plus the position-0 bass shelf) replaces the per-voice filters.
+ * Position 1 (Flat) is a true bypass, as in JunoVoiceBank. Coefficients come
+ * from the voice manager's shared cache: switching never allocates.
+ */
+class JunoBusHPF {
+public:
+    void prepare(const JunoHPFCoefficients& cache, int maxBlockSize) {
+        coefficients = &cache;
+        juce::dsp::ProcessSpec spec { cache.sampleRate, (juce::uint32)juce::jmax(1, maxBlockSize), 1 };
+        hpf.prepare(spec);
+        shelf.coefficients = cache.shelf;
+        shelf.prepare(spec);
+        position = -1;
+        reset();
+    }
+
+    void reset() {
+        hpf.reset();
+        shelf.reset();
+    }
+
+    void setPosition(int newPosition) {
+        if (coefficients == nullptr || newPosition == position) return;
+        position = newPosition;
+        hpf.coefficients = coefficients->forPosition(position);
+    }
+
+    void process(float* bus, int numSamples) {
+        if (coefficients == nullptr || position == 1) return;
+
+        if (position == 0) {
+            for (int i = 0; i < numSamples; ++i)
+                bus[i] = shelf.processSample(hpf.processSample(bus[i]));
+        } else {
+            for (int i = 0; i < numSamples; ++i)
+                bus[i] = hpf.processSample(bus[i]);
+        }
+    }
+
+private:
+    const JunoHPFCoefficients* coefficients = nullptr; // Owned by JunoVoiceManager
+    juce::dsp::IIR::Filter<float> hpf;
+    juce::dsp::IIR::Filter<float> shelf; // +2dB bump at 100Hz layered on position 0
+    int position = -1;
+};
@@ -0,0 +1,55 @@
+// Source/Synth/JunoCurveTables.cpp
+#include "JunoCurveTables.h"
+#include "../Core/JunoConstants.h"
+#include "../Core/SynthParams.h"
+#include <cmath>
+
+using namespace JunoConstants;
+
+namespace
+{
+    template <typename Fn>
+    void fill(JunoCurveTables::Table& t, Fn&& curve) {
+        for (int i = 0; i <= JunoCurveTables::kSize; ++i)
+            t[(size_t)i] = curve((float)i / (float)JunoCurveTables::kSize);
+    }
+
+    // [Fidelidad] Exponential slider mapping (formerly the curveMap lambdas in Voice / JunoVoiceBank)
+    float curveMap(float val, float minV, float maxV) { return minV * std::pow(maxV / minV, val); }
+}
+
+const JunoCurveTables& JunoCurveTables::get() {
+    static const JunoCurveTables tables; // Built once per process (thread-safe static init)
+    return tables;
+}
+
+JunoCurveTables::JunoCurveTables() {
+    fill(attack, [](float v) { return curveMap(v, Curves::kAttackMin, Curves::kAttackMax); });
+    fill(decay, [](float v) { return curveMap(v, Curves::kDecayMin, Curves::kDecayMax); });
+    fill(release, [](float v) { return curveMap(v, Curves::kReleaseMin, Curves::kReleaseMax); });
+
+    // [Fidelity] Refined VCF Curve: Target 20kHz at max, but more "open" in mid-range (exponent 0.65)
+    fill(cutoff, [](float v) { return 10.0f * std::pow(2000.0f, std::pow(v, 0.65f)); });
+    fill(lfoRate, [](float v) { return curveMap(v, JunoTimeCurves::kLfoMinHz, JunoTimeCurves::kLfoMaxHz); });
+
+    // [Audit Fix] Exponential mapping for Portamento Knob (better sensitivity)
+    fill(portamento, [](float v) { return v * v * 5.0f; });
+}
+
+void JunoCurveTables::EnvelopeRates::prepare(double sampleRate) {
+    if (sampleRate <= 0.0 || sampleRate == preparedRate) return;
+    preparedRate = sampleRate;
+
+    // Same maths as JunoADSR::calculateRates, evaluated once per grid point
+    mcuUpdateRateSamples = juce::jmax(1, (int)(0.003 * sampleRate)); // 3ms
+    const float interval = (float)mcuUpdateRateSamples;
+    const float sr = (float)sampleRate;
+    const auto& curves = JunoCurveTables::get();
+
+    for (int i = 0; i <= kSize; ++i) {
+        const size_t k = (size_t)i;
+        attack[k] = 1.0f - std::exp(-interval / (curves.attack[k] * sr * 0.35f));
+        decay[k] = std::exp(-interval / (curves.decay[k] * sr));
+        release[k] = std::exp(-interval / (curves.release[k] * sr));
+    }
+}
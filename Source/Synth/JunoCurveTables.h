@@ -0,0 +1,67 @@
+// Source/Synth/JunoCurveTables.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <cmath>
+
+/**
+ * JunoCurveTables - Precomputed panel curves, shared by every instance
+ *
+ * Every Juno-106 slider is 7-bit, so the exponential panel mappings (ADSR times,
+ * cutoff, LFO rate, portamento) are sampled once per process on a 1024-point grid
+ * (8 points per 7-bit step) and linearly interpolated, which also covers smoothed
+ * values. get() builds the tables on first use; call it from prepare so the audio
+ * thread only ever reads them.
+ *
+ * EnvelopeRates holds the sample-rate dependent MCU-tick coefficients derived from
+ * the time curves. Instances may run at different rates, so each voice manager owns
+ * one and rebuilds it only when the rate changes.
+ */
+class JunoCurveTables {
+public:
+    static constexpr int kSize = 1024;
+    using Table = std::array<float, kSize + 1>;
+
+    static const JunoCurveTables& get();
+
+    float attackSeconds(float v) const noexcept { return lookup(attack, v); }
+    float decaySeconds(float v) const noexcept { return lookup(decay, v); }
+    float releaseSeconds(float v) const noexcept { return lookup(release, v); }
+    float cutoffHz(float v) const noexcept { return lookup(cutoff, v); }        // 10 * 2000^(v^0.65)
+    float lfoRateHz(float v) const noexcept { return lookup(lfoRate, v); }
+    float portamentoSeconds(float v) const noexcept { return lookup(portamento, v); }
+
+    /** [Audit Fix] Power curve on the global drift (0-1) for better resolution in low values. */
+    static float thermalDrift(float drift) noexcept { return juce::jlimit(0.0f, 1.0f, std::pow(juce::jmax(0.0f, drift), 1.5f)); }
+
+    /** Linear interpolation on a [0, 1] grid; v is clamped. */
+    static float lookup(const Table& t, float v) noexcept {
+        const float x = juce::jlimit(0.0f, 1.0f, v) * (float)kSize;
+        const int i = juce::jmin((int)x, kSize - 1);
+        const float frac = x - (float)i;
+        return t[(size_t)i] + frac * (t[(size_t)i + 1] - t[(size_t)i]);
+    }
+
+    /** MCU-tick envelope coefficients (JunoADSR::calculateRates) for one sample rate. */
+    struct EnvelopeRates {
+        void prepare(double sampleRate);
+
+        float attackRate(float v) const noexcept { return lookup(attack, v); }
+        float decayRate(float v) const noexcept { return lookup(decay, v); }
+        float releaseRate(float v) const noexcept { return lookup(release, v); }
+        int getMcuUpdateRateSamples() const noexcept { return mcuUpdateRateSamples; }
+
+    private:
+        Table attack {}, decay {}, release {};
+        int mcuUpdateRateSamples = 132;
+        double preparedRate = 0.0;
+    };
+
+private:
+    JunoCurveTables();
+
+    Table attack, decay, release, cutoff, lfoRate, portamento;
+
+    JUCE_DECLARE_NON_COPYABLE(JunoCurveTables)
+};
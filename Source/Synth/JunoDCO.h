@@ -2,6 +2,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "../Core/JunoConstants.h"
 
 /**
  * JunoDCO - Complete Authentic Juno-106 DCO
@@ -17,12 +18,14 @@
  * 
  * JUCE COMPONENTS USED:
  * - juce::dsp::Oscillator for Sawtooth
- * - juce::Random for Noise
+ * - JunoNoiseBank for Noise (one source for every voice, fed in per sample)
  * - Custom for Pulse (PWM slew support)
  * - Custom for Sub-osc (flip-flop authentic)
  */
 class JunoDCO {
 public:
+    static constexpr int kControlInterval = 32; // Samples between drift / vibrato / divider updates
+
     enum class Range {
         Range16 = 0,  // -1 octave (×0.5)
         Range8 = 1,   // Normal (×1.0) - DEFAULT
@@ -44,6 +47,7 @@ public:
     
     // RANGE (16', 8', 4')
     void setRange(Range range);
+    float getRangeMultiplier() const noexcept { return rangeMultiplier; }
     
     // Waveform levels (0-1)
     void setPulseLevel(float level);
@@ -60,9 +64,21 @@ public:
     
     // Character
     void setDrift(float amount);        // 0-1 (analog drift)
+    void setRandomSeed(juce::int64 seed) { noiseGen.setSeed(seed); } // Seeded renders (see JunoRandom)
     
+    // Waveform switches as bits, for the compile-time specialised kernels
+    enum WaveBits : unsigned { kSawBit = 1, kPulseBit = 2, kSubBit = 4, kNoiseBit = 8, kNumWaveMasks = 16 };
+
+    /** Enabled waveforms (level > 0) as WaveBits; only changes with the level setters. */
+    unsigned getWaveMask() const noexcept { return waveMask; }
+
     // Processing (receives LFO value from external LFO)
-    float getNextSample(float lfoValue);
+    // noiseSample: the shared, already coloured noise (JunoNoiseBank::getNoise)
+    float getNextSample(float lfoValue, float noiseSample = 0.0f); // Dispatches to renderSample<getWaveMask()>
+
+    /** Sample kernel with the waveform switches resolved at compile time. Waves must equal getWaveMask(). */
+    template <unsigned Waves>
+    float renderSample(float lfoValue, float noiseSample) noexcept;
     
 private:
         float globalDriftPhase = 0.0f; // [Fix] Thread-safe per-instance drift phase
@@ -72,7 +88,13 @@ private:
     juce::Random noiseGen;
     
     // Manual oscillators
-    double pulsePhase = 0.0;
+    // [Fidelity] 8253 model: integer counter reload + 32-bit fixed-point phase (2^32 = one cycle)
+    uint32_t phaseAcc = 0;
+    uint32_t phaseInc = 0;
+    uint32_t timerReload = 0;           // 0 = not programmed yet
+    float cachedSemitones = 1.0e9f;     // Pitch inputs of the current reload value
+    float cachedBaseFrequency = 0.0f;
+    static constexpr float kPhaseScale = 1.0f / 16777216.0f; // 2^-24
     
     // Spec
     double sampleRate = 44100.0;
@@ -87,6 +109,7 @@ private:
     float sawLevel = 0.5f;
     float subLevel = 0.0f;
     float noiseLevel = 0.0f;
+    unsigned waveMask = kSawBit | kPulseBit;
     
     // PWM
     float pwmValue = 0.5f;
@@ -106,11 +129,118 @@ private:
     bool subFlipFlop = false;
     // JUCE DSP
     juce::dsp::Oscillator<float> sawOsc;
-    juce::dsp::IIR::Filter<float> noiseFilter;
     // noiseGen removed (duplicate)
     
+    // Control rate state
+    int controlCountdown = 0;
+    
     // Helpers
     void updateRangeMultiplier();
+    void updateControl(float lfoValue);
+    void updateWaveMask();
+
+    // PolyBLEP residual (Kill metallic aliasing)
+    static float polyBlep(float t, float dt) noexcept {
+        if (t < dt) { // Near start 0
+            const float x = t / dt;
+            return 2.0f * x - x * x - 1.0f;
+        }
+        if (t > 1.0f - dt) { // Near end 1
+            const float x = (t - 1.0f) / dt;
+            return x * x + 2.0f * x + 1.0f;
+        }
+        return 0.0f;
+    }
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(JunoDCO)
 };
+
+// [Optimization] Defined in the header so Voice's specialised kernels inline it
+template <unsigned Waves>
+float JunoDCO::renderSample(float lfoValue, float noiseSample) noexcept {
+    using namespace JunoConstants;
+    if (--controlCountdown < 0) updateControl(lfoValue);
+    
+    // === UPDATE PHASE ===
+    // [Optimization] Integer accumulator: the wrap is the counter's natural overflow
+    const uint32_t previousPhase = phaseAcc;
+    phaseAcc += phaseInc;
+    if (phaseAcc < previousPhase) {
+        subFlipFlop = !subFlipFlop; // Always toggle (Authentic Aliasing/Divider behavior)
+    }
+
+    // Top 24 bits convert exactly, so the float phase stays in [0, 1)
+    const float pulsePhase = (float)(phaseAcc >> 8) * kPhaseScale;
+    const float dt = (float)(phaseInc >> 8) * kPhaseScale;
+    
+    float output = 0.0f;
+
+    if constexpr ((Waves & kSawBit) != 0) {
+        // Falling saw: jumps from -1.0 to 1.0 at phase 0.0 (Magnitude +2.0)
+        float saw = 1.0f - 2.0f * pulsePhase;
+        // Corrected Sign & Magnitude: Subtracting 2x the BLEP residue for -2.0 jump
+        saw -= 2.0f * polyBlep(pulsePhase, dt);
+        output += saw * sawLevel;
+    }
+    
+    // === 2. PULSE with PWM (PolyBLEP) ===
+    if constexpr ((Waves & kPulseBit) != 0) {
+        float targetPWM = kPwmCenterDuty;
+        if (pwmMode == PWMMode::Manual) {
+            // [Fidelity] Juno-106: 50% at center, 95% at max
+            targetPWM = kPwmCenterDuty + (pwmValue - 0.5f) * 2.0f * (kPwmMaxDuty - kPwmCenterDuty);
+        } else {
+            // LFO depth applies to the 50% center
+            targetPWM = juce::jlimit(kPwmMinDuty, kPwmMaxDuty, kPwmCenterDuty + lfoValue * pwmValue * 0.45f);
+        }
+        
+        // PWM "Off" mode: force waveform level if too narrow
+        if (targetPWM > kPwmOffThreshold) targetPWM = 1.0f;
+        if (targetPWM < (1.0f - kPwmOffThreshold)) targetPWM = 0.0f;
+        
+        // [Fidelity] PWM Slew Calibrated
+        float slewRate = (pwmMode == PWMMode::Manual) ? kPwmSlewRateManual : kPwmSlewRateLFO;
+        currentPWM += (targetPWM - currentPWM) * slewRate;
+        
+        float pulse = (pulsePhase < currentPWM) ? 1.0f : -1.0f;
+        
+        // Rising edge at 0 (Jump +2.0)
+        pulse += 2.0f * polyBlep(pulsePhase, dt);
+        
+        // Falling edge at currentPWM (Jump -2.0)
+        float relativePhase = pulsePhase - currentPWM;
+        if (relativePhase < 0.0f) relativePhase += 1.0f;
+        pulse -= 2.0f * polyBlep(relativePhase, dt);
+        
+        output += pulse * pulseLevel;
+    }
+    
+    // === 3. SUB-OSCILLATOR (PolyBLEP) ===
+    if constexpr ((Waves & kSubBit) != 0) {
+        // [Fidelity] Sub-Osc is a square wave from 8253 divider.
+        // It toggles at pulsePhase == 0.5 and remains continuous at pulsePhase == 0.0.
+        // Thus, we only need PolyBLEP at the 0.5 threshold.
+        float subThreshold = 0.5f; 
+        float sub = (pulsePhase < subThreshold) == subFlipFlop ? 1.0f : -1.0f;
+        
+        // PolyBLEP at 0.5 transition
+        float relativePhase = pulsePhase - subThreshold;
+        if (relativePhase < 0.0f) relativePhase += 1.0f;
+        
+        // The jump magnitude is 2.0 (1 to -1 or -1 to 1) 
+        float blep = polyBlep(relativePhase, dt);
+        if (subFlipFlop) sub -= 2.0f * blep;
+        else sub += 2.0f * blep;
+        
+        output += sub * subLevel * kSubAmpScale;
+    }
+    
+    // === 4. NOISE ===
+    if constexpr ((Waves & kNoiseBit) != 0) {
+        // [Fidelidad] Single shared generator, coloured once per block by JunoNoiseBank
+        output += noiseSample * noiseLevel;
+    }
+    
+    // [Fidelity] Output Gain restored
+    return output;  
+}
@@ -0,0 +1,41 @@
+// Source/Synth/JunoHPFCoefficients.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include "../Core/JunoConstants.h"
+
+/**
+ * JunoHPFCoefficients - Precomputed coefficient sets for the 4-position HPF
+ *
+ * Built once per sample rate from prepareToPlay and shared by every voice.
+ * The audio thread only swaps reference-counted pointers, so changing the
+ * HPF switch never allocates (the cache keeps every set alive).
+ */
+struct JunoHPFCoefficients {
+    using Ptr = juce::dsp::IIR::Coefficients<float>::Ptr;
+    static constexpr int kNumPositions = 4;
+
+    std::array<Ptr, kNumPositions> hpf;
+    Ptr shelf; // +2dB bump at 100Hz layered on position 0
+    double sampleRate = 0.0;
+
+    void prepare(double sr) {
+        if (sr == sampleRate && shelf != nullptr) return;
+        sampleRate = sr;
+
+        using Coeffs = juce::dsp::IIR::Coefficients<float>;
+        // Position 0: [Fidelity] Bass Boost (+3dB @ 70Hz shelving)
+        hpf[0] = Coeffs::makeLowShelf(sr, JunoConstants::HPF::kShelfFreq, 0.707f, std::pow(10.0f, JunoConstants::HPF::kShelfGainDb / 20.0f));
+        // Position 1: Bypass (All-pass)
+        hpf[1] = Coeffs::makeAllPass(sr, 1000.0f);
+        // Position 2: 225Hz / Position 3: 700Hz
+        hpf[2] = Coeffs::makeHighPass(sr, JunoConstants::HPF::kFreq2, 0.707f);
+        hpf[3] = Coeffs::makeHighPass(sr, JunoConstants::HPF::kFreq3, 0.707f);
+        shelf = Coeffs::makeLowShelf(sr, 100.0f, 0.707f, 1.25f);
+    }
+
+    const Ptr& forPosition(int position) const {
+        return hpf[(size_t) juce::jlimit(0, kNumPositions - 1, position)];
+    }
+};
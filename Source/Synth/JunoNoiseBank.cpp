@@ -0,0 +1,61 @@
+// Source/Synth/JunoNoiseBank.cpp
+#include "JunoNoiseBank.h"
+#include "../Core/JunoRandom.h"
+
+void JunoNoiseBank::prepare(double sampleRate, int blockSize, int slices) {
+    maxBlockSize = juce::jmax(1, blockSize);
+    numSlices = juce::jlimit(1, kMaxSlices, slices);
+    sliceStride = juce::jmax(kSliceStride, maxBlockSize); // [Fix] Larger blocks would overlap neighbouring slices
+
+    // White block covers every voice's slice plus the DCO noise source; padded to whole generator groups
+    const int whiteSize = maxBlockSize + numSlices * sliceStride;
+    white.assign((size_t)(((whiteSize + kStreams - 1) / kStreams) * kStreams), 0.0f);
+    coloured.assign((size_t)maxBlockSize, 0.0f);
+
+    // [Determinism] Fixed streams for seeded renders; otherwise every instance sounds different
+    juce::Random random;
+    JunoRandom::seed(random, JunoRandom::Stream::NoiseBank);
+    for (auto& s : state) {
+        s = (uint32_t)random.nextInt();
+        if (s == 0) s = 0x9E3779B9u; // xorshift never leaves 0
+    }
+
+    // [Audit Fix] Using BandPass instead of Peak to better emulate Juno noise color
+    colourFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeBandPass(sampleRate, 4000.0f, 0.5f);
+    colourFilter.prepare({ sampleRate, (juce::uint32)maxBlockSize, 1 });
+    colourFilter.reset();
+    colourActive = false;
+}
+
+void JunoNoiseBank::renderBlock(int numSamples, bool colouredNoiseNeeded) {
+    numSamples = juce::jlimit(0, maxBlockSize, numSamples);
+    const int whiteSamples = juce::jmin((int)white.size(), numSamples + numSlices * sliceStride);
+
+    // [Optimization] xorshift32 -> [-1, 1), kStreams independent lanes per step
+    float* out = white.data();
+    for (int i = 0; i < whiteSamples; i += kStreams) {
+        for (int k = 0; k < kStreams; ++k) {
+            uint32_t x = state[(size_t)k];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            state[(size_t)k] = x;
+            out[i + k] = (float)(int32_t)x * (1.0f / 2147483648.0f);
+        }
+    }
+
+    if (!colouredNoiseNeeded) {
+        if (colourActive) {
+            juce::FloatVectorOperations::clear(coloured.data(), maxBlockSize);
+            colourFilter.reset();
+            colourActive = false;
+        }
+        return;
+    }
+
+    // [Fidelity] Noise color (band-pass at 4kHz), once for all voices
+    colourActive = true;
+    const float* source = white.data() + (size_t)(numSlices * sliceStride); // Past the ripple slices
+    for (int i = 0; i < numSamples; ++i)
+        coloured[(size_t)i] = colourFilter.processSample(source[i]);
+}
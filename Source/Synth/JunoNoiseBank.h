@@ -0,0 +1,50 @@
+// Source/Synth/JunoNoiseBank.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+/**
+ * JunoNoiseBank - The single noise source shared by every voice
+ *
+ * [Fidelidad] The Juno-106 has one noise generator feeding all six voices.
+ * Once per render block this fills:
+ * - White noise from kStreams interleaved xorshift32 generators. They are
+ *   independent, so the inner loop vectorises.
+ * - The DCO noise, coloured once by the 4kHz band-pass (it used to run per voice).
+ * - Decorrelated ripple slices: voice v reads the white block at an offset of
+ *   (v % kMaxSlices) * stride samples, stride = max(kSliceStride, maxBlockSize), so
+ *   slices never overlap within a block. Voices kMaxSlices apart share a slice,
+ *   which keeps the per-block noise cost fixed for large pools.
+ *
+ * Owned by JunoVoiceManager. Voices only read it.
+ */
+class JunoNoiseBank {
+public:
+    static constexpr int kStreams = 8;       // Interleaved generators (one SIMD register of lanes)
+    static constexpr int kSliceStride = 67;  // Minimum stride. Prime: ripple slices never line up with chunk sizes
+    static constexpr int kMaxSlices = 16;
+
+    void prepare(double sampleRate, int maxBlockSize, int numSlices);
+
+    /** Renders the next numSamples (<= maxBlockSize). The coloured DCO noise is only filtered when needed. */
+    void renderBlock(int numSamples, bool colouredNoiseNeeded);
+
+    /** Band-passed DCO noise in [-1, 1] for the last block (silence when not requested). */
+    const float* getNoise() const noexcept { return coloured.data(); }
+
+    /** White noise in [-1, 1) for the last block, decorrelated per voice. */
+    const float* getRipple(int voice) const noexcept {
+        return white.data() + (size_t)((juce::jmax(0, voice) % numSlices) * sliceStride);
+    }
+
+private:
+    std::array<uint32_t, kStreams> state {};
+    std::vector<float> white, coloured;
+    juce::dsp::IIR::Filter<float> colourFilter;
+    bool colourActive = false;
+    int maxBlockSize = 0;
+    int numSlices = 1;
+    int sliceStride = kSliceStride; // >= maxBlockSize: a voice's slice never runs into the next one
+};
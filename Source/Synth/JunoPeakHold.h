@@ -0,0 +1,34 @@
+// Source/Synth/JunoPeakHold.h
+#pragma once
+
+#include <algorithm>
+
+/**
+ * JunoPeakHold - Output peak held over at least one waveform period
+ *
+ * A render chunk is shorter than the period of a low note, so its peak can fall
+ * anywhere on the waveform and understate the level. The held peak is the larger
+ * of the running window and the last complete one, so it always covers at least
+ * windowSamples. Tail culling (predictTailLevel) reads it instead of the chunk peak.
+ */
+struct JunoPeakHold {
+    void reset(float level = 0.0f) {
+        held = running = level;
+        count = 0;
+    }
+
+    void push(float blockPeak, int numSamples, int windowSamples) {
+        running = std::max(running, blockPeak);
+        count += numSamples;
+        if (count >= windowSamples) {
+            held = running;
+            running = 0.0f;
+            count = 0;
+        }
+    }
+
+    float get() const { return std::max(held, running); }
+
+    float held = 0.0f, running = 0.0f;
+    int count = 0;
+};
@@ -0,0 +1,46 @@
+// Source/Synth/JunoVCF.cpp
+#include "JunoVCF.h"
+#include <cmath>
+
+void JunoVCF::prepare(double sr) {
+    sampleRate = sr;
+    piOverSampleRate = juce::MathConstants<float>::pi / (float)sr;
+    maxCutoff = (float)(sr * 0.48);
+    reset();
+}
+
+void JunoVCF::reset() {
+    state.fill(0.0f);
+}
+
+void JunoVCF::setDrive(float newDrive) {
+    drive = juce::jmax(0.1f, newDrive);
+    invDrive = 1.0f / drive;
+}
+
+float JunoVCF::processSample(float x, float cutoffHz, float resonance) noexcept {
+    const float g = prewarp(juce::jlimit(8.0f, maxCutoff, cutoffHz) * piOverSampleRate);
+    const float G = g / (1.0f + g);
+    const float b = 1.0f - G;
+    const float k = juce::jlimit(0.0f, 0.99f, resonance) * kMaxFeedback;
+
+    // Zero-delay feedback: solve the linear loop for y4, then saturate the summed input
+    const float G4 = (G * G) * (G * G);
+    const float S = (((state[0] * G + state[1]) * G + state[2]) * G + state[3]) * b;
+    const float y4Estimate = (G4 * x + S) / (1.0f + k * G4);
+    float y = saturate((x - k * y4Estimate) * drive) * invDrive;
+
+    // Four OTA integrators (TPT one-pole each)
+    for (auto& s : state) {
+        const float v = (y - s) * G;
+        y = v + s;
+        s = y + v;
+    }
+
+    // [Fix] A blown-up state would otherwise latch the voice silent until the next reset
+    if (!std::isfinite(y)) {
+        reset();
+        return 0.0f;
+    }
+    return y;
+}
@@ -0,0 +1,58 @@
+// Source/Synth/JunoVCF.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+/**
+ * JunoVCF - IR3109-style 24dB/oct low-pass
+ *
+ * CHARACTERISTICS:
+ * - Four cascaded OTA integrators with global resonance feedback (IR3109 topology).
+ * - Input stage saturation: drive rises with resonance, as on the hardware.
+ * - Self-oscillation edge at resonance = 1.0 (loop gain k = 4).
+ *
+ * IMPLEMENTATION:
+ * - Topology-preserving (zero-delay feedback) one-pole stages, solved in closed form.
+ * - Cutoff and resonance are per-sample inputs: no coefficient objects, no smoothers,
+ *   so the envelope/LFO can modulate the filter at audio rate.
+ */
+class JunoVCF {
+public:
+    JunoVCF() = default;
+
+    void prepare(double sampleRate);
+    void reset();
+
+    void setDrive(float newDrive);
+
+    /** Filters one sample. cutoffHz is clamped to [8Hz, 0.48 * sampleRate], resonance to [0, 0.99]. */
+    float processSample(float x, float cutoffHz, float resonance) noexcept;
+
+    // Shared helpers (also used by JunoVoiceBank)
+    /** Bilinear pre-warp: tan(pi * fc / fs) via a [5/4] Pade approximant, accurate up to ~0.48 fs. */
+    static float prewarp(float w) noexcept {
+        const float w2 = w * w;
+        return w * (945.0f - 105.0f * w2 + w2 * w2) / (945.0f - 420.0f * w2 + 15.0f * w2 * w2);
+    }
+
+    /** Rational tanh approximation used for the input stage, flat beyond |x| = 3. */
+    static float saturate(float x) noexcept {
+        x = juce::jlimit(-3.0f, 3.0f, x);
+        const float x2 = x * x;
+        return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+    }
+
+    static constexpr float kMaxFeedback = 4.0f;
+
+private:
+    std::array<float, 4> state { 0.0f, 0.0f, 0.0f, 0.0f };
+
+    double sampleRate = 44100.0;
+    float piOverSampleRate = juce::MathConstants<float>::pi / 44100.0f;
+    float maxCutoff = 44100.0f * 0.48f;
+    float drive = 1.0f;
+    float invDrive = 1.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(JunoVCF)
+};
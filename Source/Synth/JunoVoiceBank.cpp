@@ -0,0 +1,564 @@
+// Source/Synth/JunoVoiceBank.cpp
+#include "JunoVoiceBank.h"
+#include "JunoVCF.h"
+#include "../Core/JunoConstants.h"
+#include "../Core/JunoRandom.h"
+#include <cmath>
+#include <limits>
+
+using namespace JunoConstants;
+
+namespace
+{
+    using Vec = juce::dsp::SIMDRegister<float>;
+
+    constexpr float kGateSlew = 0.03f;           // Matches JunoADSR GATE slew (~2ms)
+    constexpr float kRippleAmount = 0.00025f;    // Voice: (rand - 0.5) * 0.0005
+
+    inline Vec select(Vec::vMaskType mask, Vec a, Vec b) noexcept
+    {
+        return (a & mask) + (b & ~mask);
+    }
+
+    // Branch-free PolyBLEP residue (same polynomial as JunoDCO::getNextSample)
+    inline Vec polyBlep(Vec t, Vec dt, Vec invDt) noexcept
+    {
+        const Vec one = Vec::expand(1.0f);
+        const Vec x1 = t * invDt;
+        const Vec r1 = x1 * 2.0f - x1 * x1 - one;
+        const Vec x2 = (t - one) * invDt;
+        const Vec r2 = x2 * x2 + x2 * 2.0f + one;
+        return (r1 & Vec::lessThan(t, dt)) + (r2 & Vec::greaterThan(t, one - dt));
+    }
+
+    // Cubic soft clipper: ~x for small signals, flat at +/-1 beyond |x| = 1.5
+    inline Vec softClip(Vec x) noexcept
+    {
+        x = Vec::max(Vec::expand(-1.5f), Vec::min(Vec::expand(1.5f), x));
+        return x - x * x * x * (4.0f / 27.0f);
+    }
+
+    // Transposed Direct Form II biquad on a lane group
+    inline Vec biquad(Vec x, Vec& z1, Vec& z2, float b0, float b1, float b2, float a1, float a2) noexcept
+    {
+        const Vec y = x * b0 + z1;
+        z1 = x * b1 - y * a1 + z2;
+        z2 = x * b2 - y * a2;
+        return y;
+    }
+}
+
+JunoVoiceBank::JunoVoiceBank() {
+    currentNote.fill(-1);
+    gateOn.fill(false);
+    stage.fill(Stage::Idle);
+    targetNote.fill(69.0f);
+    noteSlew.fill(69.0f);
+    lastOutputLevel.fill(0.0f);
+    staticSpreadCents.fill(0.0f);
+    voiceDriftPhase.fill(0.0f);
+    voiceDriftRate.fill(0.02f);
+    globalDriftPhase.fill(0.0f);
+    globalDriftHz.fill(0.015f);
+
+    subSign.fill(1.0f);
+    pwm.fill(kPwmCenterDuty);
+}
+
+void JunoVoiceBank::prepare(double sr, int maxBlockSize) {
+    sampleRate = sr;
+    mcuUpdateRateSamples = juce::jmax(1, (int)(0.003 * sr)); // 3ms MCU tick
+    mcuCounter = 0;
+
+    // [Determinism] Seeded renders: restart drift draws from a fixed stream (noise: JunoNoiseBank)
+    JunoRandom::seed(random, JunoRandom::Stream::VoiceBank);
+
+    smoothedCutoff.reset(sr, 0.02);
+    smoothedCutoff.setCurrentAndTargetValue(params.vcfFreq);
+    smoothedResonance.reset(sr, 0.02);
+    smoothedResonance.setCurrentAndTargetValue(params.resonance);
+    smoothedVCALevel.reset(sr, 0.02);
+    smoothedVCALevel.setCurrentAndTargetValue(params.vcaLevel);
+
+    if (coefficientCache != nullptr) shelfCoeffs = toBiquad(*coefficientCache->shelf);
+    cachedHpfPosition = -1;
+    updateHPFCoefficients();
+    calculateRates();
+
+    this->maxBlockSize = juce::jmax(1, maxBlockSize);
+    reset();
+}
+
+void JunoVoiceBank::reset() {
+    for (int v = 0; v < kMaxVoices; ++v) {
+        forceStop(v);
+        resetLaneFilters(v);
+    }
+    mcuCounter = 0;
+}
+
+JunoVoiceBank::Biquad JunoVoiceBank::toBiquad(const juce::dsp::IIR::Coefficients<float>& c) {
+    // JUCE stores normalised { b0, b1, b2, a1, a2 } for second order sections
+    const float* raw = c.getRawCoefficients();
+    return { raw[0], raw[1], raw[2], raw[3], raw[4] };
+}
+
+void JunoVoiceBank::updateHPFCoefficients() {
+    if (coefficientCache == nullptr || params.hpfFreq == cachedHpfPosition) return;
+    cachedHpfPosition = params.hpfFreq;
+
+    // Same curve set as Voice. Position 1 (Flat) is a true bypass here.
+    hpfCoeffs = (cachedHpfPosition == 1) ? Biquad {} : toBiquad(*coefficientCache->forPosition(cachedHpfPosition));
+}
+
+void JunoVoiceBank::calculateRates() {
+    // [Fidelidad] Same MCU-rate coefficients as JunoADSR::calculateRates
+    // [Optimization] Looked up in the shared tables when the manager provides them
+    if (envelopeRates != nullptr && envelopeRates->getMcuUpdateRateSamples() == mcuUpdateRateSamples) {
+        attackRate = envelopeRates->attackRate(params.attack);
+        decayRate = envelopeRates->decayRate(params.decay);
+        releaseRate = envelopeRates->releaseRate(params.release);
+        return;
+    }
+
+    const float interval = (float)mcuUpdateRateSamples;
+    const float sr = (float)sampleRate;
+    const auto& curves = JunoCurveTables::get();
+
+    const float attackTime = curves.attackSeconds(params.attack);
+    const float decayTime = curves.decaySeconds(params.decay);
+    const float releaseTime = curves.releaseSeconds(params.release);
+
+    attackRate = 1.0f - std::exp(-interval / (attackTime * sr * 0.35f));
+    decayRate = std::exp(-interval / (decayTime * sr));
+    releaseRate = std::exp(-interval / (releaseTime * sr));
+}
+
+void JunoVoiceBank::updateParams(const SynthParams& p, juce::uint32 dirty) {
+    params = p;
+    if (dirty & SynthParamDirty::Vcf) {
+        smoothedCutoff.setTargetValue(p.vcfFreq);
+        smoothedResonance.setTargetValue(p.resonance);
+    }
+    if (dirty & SynthParamDirty::Vca) smoothedVCALevel.setTargetValue(p.vcaLevel);
+    if (dirty & SynthParamDirty::Thermal) driftAmount = JunoCurveTables::thermalDrift(p.thermalDrift);
+    if (dirty & SynthParamDirty::Envelope) calculateRates();
+    if (dirty & SynthParamDirty::Hpf) updateHPFCoefficients();
+}
+
+void JunoVoiceBank::forceUpdate() {
+    smoothedCutoff.setCurrentAndTargetValue(params.vcfFreq);
+    smoothedResonance.setCurrentAndTargetValue(params.resonance);
+    smoothedVCALevel.setCurrentAndTargetValue(params.vcaLevel);
+
+    // [Fix] Recover from NaN on patch change
+    for (int v = 0; v < kMaxVoices; ++v) resetLaneFilters(v);
+}
+
+void JunoVoiceBank::resetLaneFilters(int v) {
+    lp1[v] = lp2[v] = lp3[v] = lp4[v] = 0.0f;
+    hpZ1[v] = hpZ2[v] = shelfZ1[v] = shelfZ2[v] = 0.0f;
+}
+
+
+void JunoVoiceBank::noteOn(int v, int midiNote, float /*velocity*/, bool isLegato) {
+    const size_t i = (size_t)v;
+    const bool wasIdle = (currentNote[i] == -1);
+
+    currentNote[i] = midiNote;
+    gateOn[i] = true;
+    lastOutputLevel[i] = 1.0f;
+    tailPeak[i].reset(1.0f);
+    activeMask[v] = 1.0f;
+    shedStep[v] = 0.0f; // A shed voice can be stolen mid-fade
+    vcaGate[v] = 1.0f;
+    envTarget[v] = 0.97f;
+
+    targetNote[i] = (float)midiNote;
+    if (params.polyMode == 3)
+        targetNote[i] += ((float)v - 2.5f) * 0.024f; // Unison spread, as in Voice::noteOn
+
+    bool shouldGlide = params.portamentoOn;
+    if (params.portamentoLegato) shouldGlide = shouldGlide && isLegato;
+
+    if (!isLegato) {
+        stage[i] = Stage::Attack;
+        envValue[v] = 0.0f;
+        envOut[v] = 0.0f;
+
+        // DCO reset (JunoDCO::reset)
+        phase[v] = 0.0f;
+        staticSpreadCents[i] = (random.nextFloat() * 2.0f - 1.0f) * kDcoDriftMaxSpreadCents;
+        voiceDriftPhase[i] = random.nextFloat() * juce::MathConstants<float>::twoPi;
+        voiceDriftRate[i] = 0.01f + random.nextFloat() * 0.04f;
+        globalDriftHz[i] = 0.01f + random.nextFloat() * 0.01f;
+        pwm[v] = params.pwmAmount;
+        subSign[v] = random.nextBool() ? 1.0f : -1.0f;
+
+        if (wasIdle) resetLaneFilters(v);
+
+        // [Fidelidad] The MCU services a new gate on its next pass; don't wait a full tick
+        if (params.vcaMode != 1) tickEnvelope(v);
+    }
+
+    if (!shouldGlide) noteSlew[i] = targetNote[i];
+}
+
+void JunoVoiceBank::noteOff(int v) {
+    gateOn[(size_t)v] = false;
+    vcaGate[v] = 0.0f;
+    envTarget[v] = 0.0f;
+    if (stage[(size_t)v] != Stage::Idle) stage[(size_t)v] = Stage::Release;
+}
+
+void JunoVoiceBank::forceStop(int v) {
+    const size_t i = (size_t)v;
+    stage[i] = Stage::Idle;
+    currentNote[i] = -1;
+    gateOn[i] = false;
+    lastOutputLevel[i] = 0.0f;
+    tailPeak[i].reset();
+    noteSlew[i] = targetNote[i]; // Reset portamento history
+    envValue[v] = envOut[v] = envTarget[v] = 0.0f;
+    vcaGate[v] = activeMask[v] = shedStep[v] = 0.0f;
+}
+
+float JunoVoiceBank::predictTailLevel(int v) const {
+    const size_t i = (size_t)v;
+    if (gateOn[i] || isShedding(v) || params.vcaMode == 1 || stage[i] != Stage::Release)
+        return std::numeric_limits<float>::max();
+
+    // [Fidelidad] 8-bit envelope DAC: below one step the VCA is shut and the lane is silent
+    if (envOut[v] <= 0.0f) return 0.0f;
+    if (params.vcfPolarity == 1 && params.envAmount > 0.0f) return std::numeric_limits<float>::max();
+
+    const float nextDac = std::floor(envValue[v] * releaseRate * 255.99f) / 255.0f;
+    const float vcaRise = smoothedVCALevel.getTargetValue() / juce::jmax(0.001f, smoothedVCALevel.getCurrentValue());
+    return tailPeak[i].get() / envOut[v] * nextDac * juce::jmax(1.0f, vcaRise) * std::exp2(params.lfoToVCF * 4.0f);
+}
+
+void JunoVoiceBank::shed(int v, int fadeSamples) {
+    if (!isActive(v) || isShedding(v)) return;
+    shedStep[v] = 1.0f / (float)juce::jmax(1, fadeSamples);
+    gateOn[(size_t)v] = false;
+}
+
+void JunoVoiceBank::tickEnvelope(int v) {
+    // [Fidelidad] One 8031 pass, same state machine as JunoADSR::getNextSample
+    const size_t i = (size_t)v;
+    float x = envValue[v];
+
+    switch (stage[i]) {
+        case Stage::Attack:
+            x += attackRate * (1.08f - x);
+            if (x >= 1.0f) { x = 1.0f; stage[i] = Stage::Decay; }
+            break;
+        case Stage::Decay:
+            x = (x - params.sustain) * decayRate + params.sustain;
+            if (std::abs(x - params.sustain) <= 0.001f) { x = params.sustain; stage[i] = Stage::Sustain; }
+            break;
+        case Stage::Sustain:
+            x = params.sustain;
+            break;
+        case Stage::Release:
+            x *= releaseRate;
+            if (x < 0.0001f) { x = 0.0f; stage[i] = Stage::Idle; }
+            break;
+        case Stage::Idle:
+        default:
+            break;
+    }
+
+    envValue[v] = x;
+    envOut[v] = std::floor(x * 255.99f) / 255.0f; // 8-bit DAC
+}
+
+float JunoVoiceBank::updatePitch(int v, int numSamples) {
+    const size_t i = (size_t)v;
+
+    // Portamento (Voice::updatePitch)
+    if (params.portamentoOn && std::abs(noteSlew[i] - targetNote[i]) > 0.001f) {
+        float glideTime = JunoCurveTables::get().portamentoSeconds(params.portamentoTime);
+        float glideCoeff = 1.0f - std::exp(-static_cast<float>(numSamples) /
+                               (juce::jmax(0.001f, glideTime) * static_cast<float>(sampleRate)));
+        noteSlew[i] += (targetNote[i] - noteSlew[i]) * glideCoeff;
+    } else {
+        noteSlew[i] = targetNote[i];
+    }
+
+    float semitones = noteSlew[i] - 69.0f + params.tune / 100.0f;
+    if (params.bendCV() != 0.0f && params.benderToDCO > 0.0f)
+        semitones += params.bendCV() * params.benderToDCO * 2.0f;
+    semitones += params.thermalDrift * 0.1f;
+
+    // Analog drift, advanced once per block (JunoDCO::getNextSample)
+    const float twoPi = juce::MathConstants<float>::twoPi;
+    const float blockSeconds = (float)numSamples / (float)sampleRate;
+    voiceDriftPhase[i] = std::fmod(voiceDriftPhase[i] + twoPi * voiceDriftRate[i] * blockSeconds, twoPi);
+    globalDriftPhase[i] = std::fmod(globalDriftPhase[i] + twoPi * globalDriftHz[i] * blockSeconds, twoPi);
+
+    const float driftCents = staticSpreadCents[i] * driftAmount
+                           + std::sin(globalDriftPhase[i]) * kDcoDriftMaxGlobalCents * driftAmount
+                           + std::sin(voiceDriftPhase[i]) * kDcoDriftMaxVoiceCents * driftAmount;
+    semitones += driftCents / 100.0f;
+
+    const float rangeMultiplier = (params.dcoRange == 0) ? 0.5f : (params.dcoRange == 2 ? 2.0f : 1.0f);
+    float freq = 440.0f * rangeMultiplier * std::exp2(semitones / 12.0f);
+
+    // [Fidelity] 8253 TIMER QUANTIZATION (block rate; vibrato rides on top)
+    if (freq > 0.0f) {
+        uint32_t ticks = (uint32_t)(kMasterClockHz / (freq * 256.0f) + 0.5f);
+        ticks = juce::jlimit(1u, 65535u, ticks);
+        freq = kMasterClockHz / ((float)ticks * 256.0f);
+    }
+    return freq;
+}
+
+void JunoVoiceBank::updateCutoff(int v, float baseCutoff, float lfoValue, float feedback) {
+    const float env = envOut[v];
+    const float envMod = (params.vcfPolarity == 1) ? -env : env;
+
+    float octaves = (envMod * params.envAmount * 5.0f) +
+                    (lfoValue * params.lfoToVCF * 4.0f) +
+                    (params.bendCV() * params.benderToVCF * 2.0f);
+
+    if (params.kybdTracking > 0.001f)
+        octaves += ((float)currentNote[(size_t)v] - 60.0f) * params.kybdTracking / 12.0f;
+
+    const float cutoff = juce::jlimit(8.0f, (float)(sampleRate * 0.48), baseCutoff * std::exp2(octaves));
+
+    // TPT one-pole gain and the zero-delay feedback normaliser for this segment (JunoVCF kernel)
+    const float g = JunoVCF::prewarp(juce::MathConstants<float>::pi * cutoff / (float)sampleRate);
+    const float G = g / (1.0f + g);
+    const float G4 = G * G * G * G;
+    cutoffG[v] = G;
+    ladderNorm[v] = 1.0f / (1.0f + feedback * G4);
+}
+
+void JunoVoiceBank::renderNextBlock(float* bus, int numSamples, const std::vector<float>& lfoBuffer, int numVoices) {
+    numVoices = juce::jlimit(0, kMaxVoices, numVoices);
+    jassert(numSamples <= maxBlockSize); // Callers render in chunks of the prepared size
+    numSamples = juce::jmin(numSamples, maxBlockSize, (int)lfoBuffer.size());
+
+    int numActive = 0;
+    for (int v = 0; v < numVoices; ++v) if (isActive(v)) ++numActive;
+    if (numActive == 0 || numSamples <= 0) return;
+    jassert(noiseBank != nullptr);
+    if (noiseBank == nullptr) return;
+    const float* dcoNoise = noiseBank->getNoise(); // [Fidelidad] One coloured source for every lane
+
+    // --- Block-rate control ---
+    for (int v = 0; v < numVoices; ++v) {
+        if (!isActive(v)) continue;
+        const float inc = (float)(updatePitch(v, numSamples) / sampleRate);
+        phaseInc[v] = inc;
+        invPhaseInc[v] = inc > 0.0f ? 1.0f / inc : 0.0f;
+        crosstalk[v] = lastOutputLevel[(size_t)((v + 1) % numVoices)] * kVoiceCrosstalkAmount;
+        peak[v] = 0.0f;
+    }
+
+    const int numGroups = (numVoices + kLanes - 1) / kLanes;
+    const bool gateMode = (params.vcaMode == 1);
+    const float resParam = smoothedResonance.skip(numSamples);
+    const float feedback = juce::jlimit(0.0f, 0.99f, resParam) * JunoVCF::kMaxFeedback;
+    const float drive = 1.35f + (params.resonance * 0.15f);
+    const float invDrive = 1.0f / drive;
+    const float outputGain = (1.0f + resParam * resParam * 0.5f) * kVoiceOutputGain;
+
+    const float sawLevel = params.sawOn ? 1.0f : 0.0f;
+    const float pulseLevel = params.pulseOn ? 1.0f : 0.0f;
+    const float subLevel = juce::jlimit(0.0f, 1.0f, params.subOscLevel) * kSubAmpScale;
+    const float noiseLevel = juce::jlimit(0.0f, 1.0f, params.noiseLevel);
+    const float lfoDepth = juce::jlimit(0.0f, 1.0f, params.lfoToDCO);
+    const bool pwmFromLfo = (params.pwmMode == 1);
+    const float pwmSlew = pwmFromLfo ? kPwmSlewRateLFO : kPwmSlewRateManual;
+    // Legacy per-voice HPF only; with params.busHpf the processor filters the summed bus
+    const bool hpfActive = !params.busHpf && (cachedHpfPosition != 1);
+    const bool shelfActive = !params.busHpf && (cachedHpfPosition == 0);
+
+    const Vec zero = Vec::expand(0.0f);
+    const Vec one = Vec::expand(1.0f);
+    const Vec half = Vec::expand(0.5f);
+    const Vec minusOne = Vec::expand(-1.0f);
+    const Vec two = Vec::expand(2.0f);
+    const Vec satThreshold = Vec::expand(kDcoMixerSaturationThreshold);
+
+    float vibrato[kMaxSegment];
+    float pwmTarget[kMaxSegment];
+
+    int pos = 0;
+    while (pos < numSamples) {
+        // [Fidelidad] Shared 8031 tick services every envelope at once
+        if (mcuCounter <= 0) {
+            mcuCounter = mcuUpdateRateSamples;
+            if (!gateMode)
+                for (int v = 0; v < numVoices; ++v) if (isActive(v)) tickEnvelope(v);
+        }
+
+        const int seg = juce::jmin(numSamples - pos, mcuCounter, kMaxSegment);
+        mcuCounter -= seg;
+
+        // --- Segment-rate control ---
+        const float vcfParam = smoothedCutoff.skip(seg);
+        const float vcaLevel = smoothedVCALevel.skip(seg);
+        const float baseCutoff = JunoCurveTables::get().cutoffHz(vcfParam);
+
+        for (int v = 0; v < numVoices; ++v) {
+            if (!isActive(v)) continue;
+            updateCutoff(v, baseCutoff, lfoBuffer[(size_t)pos], feedback);
+            const float* ripple = noiseBank->getRipple(v) + pos;
+            for (int s = 0; s < seg; ++s) noiseScratch[(size_t)s][v] = ripple[s];
+        }
+
+        // Shared per-sample terms: vibrato ratio and PWM target depend only on the LFO
+        for (int s = 0; s < seg; ++s) {
+            const float lfo = lfoBuffer[(size_t)(pos + s)];
+            vibrato[s] = std::exp2((lfo * lfoDepth * 0.5f) / 12.0f);
+
+            float target = pwmFromLfo
+                ? juce::jlimit(kPwmMinDuty, kPwmMaxDuty, kPwmCenterDuty + lfo * params.pwmAmount * 0.45f)
+                : kPwmCenterDuty + (params.pwmAmount - 0.5f) * 2.0f * (kPwmMaxDuty - kPwmCenterDuty);
+            if (target > kPwmOffThreshold) target = 1.0f;
+            if (target < (1.0f - kPwmOffThreshold)) target = 0.0f;
+            pwmTarget[s] = target;
+        }
+
+        // --- Audio rate: one lane group at a time ---
+        for (int g = 0; g < numGroups; ++g) {
+            Vec active = activeMask.load(g);
+            if (active.sum() == 0.0f) continue;
+            const Vec shedDec = shedStep.load(g);
+            const bool shedding = shedDec.sum() > 0.0f;
+
+            Vec t = phase.load(g), inc = phaseInc.load(g), invInc = invPhaseInc.load(g);
+            Vec sub = subSign.load(g), pw = pwm.load(g);
+            Vec env = envOut.load(g), envRaw = envValue.load(g);
+            const Vec envTgt = envTarget.load(g), gate = vcaGate.load(g), xtalk = crosstalk.load(g);
+            Vec s1 = lp1.load(g), s2 = lp2.load(g), s3 = lp3.load(g), s4 = lp4.load(g);
+            Vec h1 = hpZ1.load(g), h2 = hpZ2.load(g), sh1 = shelfZ1.load(g), sh2 = shelfZ2.load(g);
+            const Vec G = cutoffG.load(g), norm = ladderNorm.load(g);
+            const Vec G4 = G * G * G * G, oneMinusG = one - G;
+            Vec pk = peak.load(g);
+
+            for (int s = 0; s < seg; ++s) {
+                const Vec white = noiseScratch[(size_t)s].load(g);
+
+                if (gateMode) {
+                    envRaw = envRaw + (envTgt - envRaw) * kGateSlew;
+                    env = Vec::truncate(envRaw * 255.99f) * (1.0f / 255.0f);
+                }
+
+                // 1. DCO
+                const Vec dt = inc * vibrato[s];
+                const Vec invDt = invInc * (1.0f / vibrato[s]);
+                t = t + dt;
+                const auto wrapped = Vec::greaterThanOrEqual(t, one);
+                t = t - (one & wrapped);
+                sub = sub - ((sub * 2.0f) & wrapped); // 8253 flip-flop toggles on every wrap
+
+                Vec dco = zero;
+                if (sawLevel > 0.0f)
+                    dco = dco + (one - t * 2.0f - polyBlep(t, dt, invDt) * 2.0f) * sawLevel;
+
+                if (pulseLevel > 0.0f) {
+                    pw = pw + (Vec::expand(pwmTarget[s]) - pw) * pwmSlew;
+                    Vec pulse = minusOne + (two & Vec::lessThan(t, pw));
+                    Vec rel = t - pw;
+                    rel = rel + (one & Vec::lessThan(rel, zero));
+                    pulse = pulse + polyBlep(t, dt, invDt) * 2.0f - polyBlep(rel, dt, invDt) * 2.0f;
+                    dco = dco + pulse * pulseLevel;
+                }
+
+                if (subLevel > 0.0f) {
+                    Vec rel = t - half;
+                    rel = rel + (one & Vec::lessThan(rel, zero));
+                    const Vec square = minusOne + (two & Vec::lessThan(t, half));
+                    const Vec subOut = square * sub - sub * polyBlep(rel, dt, invDt) * 2.0f;
+                    dco = dco + subOut * subLevel;
+                }
+
+                if (noiseLevel > 0.0f)
+                    dco = dco + Vec::expand(dcoNoise[pos + s] * noiseLevel);
+
+                // Soft-clipper (DCO Mixer saturation)
+                const Vec x = dco * 1.15f;
+                dco = select(Vec::greaterThan(Vec::abs(dco), satThreshold), x - x * x * x * (1.0f / 24.0f), dco);
+
+                const Vec in = dco + xtalk + white * env * kRippleAmount;
+
+                // 2. VCF: zero-delay-feedback 4-pole ladder
+                const Vec S = (((s1 * G + s2) * G + s3) * G + s4) * oneMinusG;
+                const Vec y4Estimate = (G4 * in + S) * norm;
+                const Vec u = softClip((in - y4Estimate * feedback) * drive) * invDrive;
+
+                Vec v = (u - s1) * G;  const Vec y1 = v + s1;  s1 = y1 + v;
+                v = (y1 - s2) * G;     const Vec y2 = v + s2;  s2 = y2 + v;
+                v = (y2 - s3) * G;     const Vec y3 = v + s3;  s3 = y3 + v;
+                v = (y3 - s4) * G;     Vec out = v + s4;       s4 = out + v;
+
+                // 3. HPF (after LPF, as on the hardware)
+                if (hpfActive)
+                    out = biquad(out, h1, h2, hpfCoeffs.b0, hpfCoeffs.b1, hpfCoeffs.b2, hpfCoeffs.a1, hpfCoeffs.a2);
+                if (shelfActive)
+                    out = biquad(out, sh1, sh2, shelfCoeffs.b0, shelfCoeffs.b1, shelfCoeffs.b2, shelfCoeffs.a1, shelfCoeffs.a2);
+
+                // 4. VCA + output stage saturation
+                const Vec vca = gateMode ? gate * vcaLevel : env * vcaLevel;
+                if (shedding) active = Vec::max(zero, active - shedDec);
+                out = softClip(out * vca * outputGain) * active;
+
+                pk = Vec::max(pk, Vec::abs(out));
+                bus[pos + s] += out.sum();
+            }
+
+            phase.store(g, t);
+            subSign.store(g, sub);
+            pwm.store(g, pw);
+            envOut.store(g, env);
+            envValue.store(g, envRaw);
+            lp1.store(g, s1); lp2.store(g, s2); lp3.store(g, s3); lp4.store(g, s4);
+            hpZ1.store(g, h1); hpZ2.store(g, h2); shelfZ1.store(g, sh1); shelfZ2.store(g, sh2);
+            peak.store(g, pk);
+            if (shedding) activeMask.store(g, active);
+        }
+
+        // GATE mode release ends once the slew has settled (JunoADSR gate branch)
+        if (gateMode) {
+            for (int v = 0; v < numVoices; ++v) {
+                if (stage[(size_t)v] == Stage::Release && envValue[v] < 0.001f) {
+                    envValue[v] = 0.0f;
+                    stage[(size_t)v] = Stage::Idle;
+                }
+            }
+        }
+
+        pos += seg;
+    }
+
+    // --- Voice bookkeeping (Voice::processFinalOutput) ---
+    for (int v = 0; v < numVoices; ++v) {
+        if (!isActive(v)) continue;
+
+        float level = peak[v];
+        if (!std::isfinite(level) || !std::isfinite(lp4[v])) {
+            resetLaneFilters(v);
+            level = 0.0f;
+        }
+        lastOutputLevel[(size_t)v] = level;
+        // phaseInc includes the range: the sub-oscillator period is two of its cycles
+        tailPeak[(size_t)v].push(level, numSamples, (int)std::ceil(2.0f * invPhaseInc[v]));
+
+        // Shed voice: stop once the fade has reached silence
+        if (isShedding(v) && activeMask[v] <= 0.0f) {
+            forceStop(v);
+            continue;
+        }
+
+        // [Fidelity] "Voice Kill" threshold (~0.4%)
+        if (stage[(size_t)v] == Stage::Idle && level < kVoiceKillThreshold) {
+            currentNote[(size_t)v] = -1;
+            gateOn[(size_t)v] = false;
+            activeMask[v] = 0.0f;
+        }
+    }
+}
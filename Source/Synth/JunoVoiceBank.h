@@ -0,0 +1,146 @@
+// Source/Synth/JunoVoiceBank.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+#include "../Core/SynthParams.h"
+#include "JunoHPFCoefficients.h"
+#include "JunoCurveTables.h"
+#include "JunoNoiseBank.h"
+#include "JunoPeakHold.h"
+
+/**
+ * JunoVoiceBank - Structure-of-Arrays voice engine
+ *
+ * Renders every voice of the JUNiO 601 as lanes of a SIMD register instead of
+ * one Voice object at a time. DCO phase, envelope, VCF/HPF state and VCA gain
+ * live in lane-aligned arrays, so a lane group (4 voices on SSE/NEON, 8 on AVX)
+ * goes through DCO -> VCF -> HPF -> VCA in a single pass.
+ *
+ * STRUCTURE:
+ * - Control rate (scalar, per voice): pitch, portamento, drift, envelope ticks.
+ * - Audio rate (SIMD, per lane group): PolyBLEP DCO, 24dB ladder, HPF biquads, VCA.
+ * - Envelopes are ticked by one shared 3ms MCU clock, like the single 8031
+ *   that services all voices on the hardware.
+ *
+ * The Voice class stays as the reference implementation; JunoVoiceManager
+ * selects between both engines (see JunoVoiceManager::setRenderEngine).
+ */
+class JunoVoiceBank {
+public:
+    static constexpr int kMaxVoices = 128; // Lanes past the manager's voice limit are never touched while rendering
+
+    JunoVoiceBank();
+
+    void prepare(double sampleRate, int maxBlockSize);
+    void reset();
+    void setCoefficientCache(const JunoHPFCoefficients* cache) { coefficientCache = cache; }
+    void setEnvelopeRates(const JunoCurveTables::EnvelopeRates* rates) { envelopeRates = rates; }
+    void setNoiseBank(const JunoNoiseBank* bank) { noiseBank = bank; } // Rendered ahead of the lanes
+
+    /** Adds every active voice into a mono bus (stereo only appears at the chorus stage). */
+    void renderNextBlock(float* bus, int numSamples, const std::vector<float>& lfoBuffer, int numVoices);
+
+    // Per-voice lifecycle (mirrors the Voice API used by JunoVoiceManager)
+    void noteOn(int voice, int midiNote, float velocity, bool isLegato);
+    void noteOff(int voice);
+    void forceStop(int voice);
+    void shed(int voice, int fadeSamples); // Load shedding: short linear fade, then forceStop()
+
+    bool isActive(int voice) const { return currentNote[(size_t)voice] != -1; }
+    bool isShedding(int voice) const { return shedStep[voice] > 0.0f; }
+    float predictTailLevel(int voice) const; // Voice::predictTailLevel
+    int getCurrentNote(int voice) const { return currentNote[(size_t)voice]; }
+    bool isGateOnActive(int voice) const { return gateOn[(size_t)voice]; }
+    float lastActiveOutputLevel(int voice) const { return lastOutputLevel[(size_t)voice]; }
+
+    // Shared patch state (all lanes play the same patch)
+    void updateParams(const SynthParams& params, juce::uint32 dirty = SynthParamDirty::All); // SynthParamDirty groups
+    void forceUpdate();
+
+    void setBender(float v) { params.benderValue = v; }
+    void setThermalDrift(float drift, float curvedDrift) { params.thermalDrift = drift; driftAmount = curvedDrift; }
+    void setPortamentoEnabled(bool b) { params.portamentoOn = b; }
+    void setPortamentoTime(float v) { params.portamentoTime = v; }
+    void setPortamentoLegato(bool b) { params.portamentoLegato = b; }
+
+private:
+    using Vec = juce::dsp::SIMDRegister<float>;
+    static constexpr int kLanes = (int) Vec::SIMDNumElements;
+    static constexpr int kNumGroups = (kMaxVoices + kLanes - 1) / kLanes;
+    static constexpr int kPaddedVoices = kNumGroups * kLanes;
+    static constexpr int kMaxSegment = 32; // Control-rate update interval (samples)
+
+    /** One float per lane, aligned so a lane group loads straight into a register. */
+    struct alignas (Vec::SIMDRegisterSize) LaneBuffer {
+        float v[kPaddedVoices] {};
+
+        Vec load(int group) const noexcept { return Vec::fromRawArray(v + group * kLanes); }
+        void store(int group, Vec x) noexcept { x.copyToRawArray(v + group * kLanes); }
+        float& operator[](int i) noexcept { return v[i]; }
+        float operator[](int i) const noexcept { return v[i]; }
+        void fill(float x) noexcept { std::fill(std::begin(v), std::end(v), x); }
+    };
+
+    enum class Stage : uint8_t { Idle, Attack, Decay, Sustain, Release };
+
+    // --- Control state (scalar, per voice) ---
+    std::array<int, kMaxVoices> currentNote;
+    std::array<bool, kMaxVoices> gateOn;
+    std::array<Stage, kMaxVoices> stage;
+    std::array<float, kMaxVoices> targetNote;
+    std::array<float, kMaxVoices> noteSlew;
+    std::array<float, kMaxVoices> lastOutputLevel;
+    std::array<JunoPeakHold, kMaxVoices> tailPeak; // Output peak over >= one sub-oscillator period (predictTailLevel)
+    std::array<float, kMaxVoices> staticSpreadCents;
+    std::array<float, kMaxVoices> voiceDriftPhase;
+    std::array<float, kMaxVoices> voiceDriftRate;
+    std::array<float, kMaxVoices> globalDriftPhase;
+    std::array<float, kMaxVoices> globalDriftHz;
+
+    // --- Audio state (SoA, per lane) ---
+    LaneBuffer phase, phaseInc, invPhaseInc, subSign, pwm;
+    LaneBuffer envValue, envOut, envTarget;   // Unquantised MCU value / 8-bit DAC output / GATE target
+    LaneBuffer vcaGate, activeMask, crosstalk; // activeMask: 1 playing, 0 idle, ramps down while shed
+    LaneBuffer shedStep;                      // Per-sample activeMask decrement, 0 = not shedding
+    LaneBuffer lp1, lp2, lp3, lp4;            // 4-pole ladder integrators
+    LaneBuffer hpZ1, hpZ2, shelfZ1, shelfZ2;  // HPF / bass boost biquads (TDF-II)
+    LaneBuffer cutoffG, ladderNorm, peak;   // Per-segment TPT gain, feedback normaliser, block peak
+
+    // Scratch: per-lane ripple noise for one segment (JunoNoiseBank slices)
+    std::array<LaneBuffer, kMaxSegment> noiseScratch;
+    int maxBlockSize = 512;
+
+    // --- Shared patch state ---
+    SynthParams params;
+    juce::LinearSmoothedValue<float> smoothedCutoff;
+    juce::LinearSmoothedValue<float> smoothedResonance;
+    juce::LinearSmoothedValue<float> smoothedVCALevel;
+
+    juce::Random random;
+    double sampleRate = 44100.0;
+    int mcuUpdateRateSamples = 132;
+    int mcuCounter = 0;
+    float attackRate = 0.0f, decayRate = 0.0f, releaseRate = 0.0f;
+    float driftAmount = 0.0f; // JunoCurveTables::thermalDrift(params.thermalDrift)
+    int cachedHpfPosition = -1;
+    const JunoHPFCoefficients* coefficientCache = nullptr; // Owned by JunoVoiceManager
+    const JunoCurveTables::EnvelopeRates* envelopeRates = nullptr; // Owned by JunoVoiceManager
+    const JunoNoiseBank* noiseBank = nullptr; // Owned by JunoVoiceManager
+
+    struct Biquad { float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f; };
+    Biquad hpfCoeffs, shelfCoeffs;
+
+    // Helpers
+    void calculateRates();
+    void updateHPFCoefficients();
+    void tickEnvelope(int voice);
+    float updatePitch(int voice, int numSamples);
+    void updateCutoff(int voice, float baseCutoff, float lfoValue, float feedback);
+    void resetLaneFilters(int voice);
+
+    static Biquad toBiquad(const juce::dsp::IIR::Coefficients<float>& c);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(JunoVoiceBank)
+};
@@ -1,17 +1,23 @@
 #include "Voice.h"
 #include <cmath>
+#include <limits>
 #include "../Core/SynthParams.h"
 #include "../Core/JunoConstants.h"
+#include "../Core/JunoRandom.h"
+#include "JunoCurveTables.h"
 
 using namespace JunoConstants;
 
 Voice::Voice() {
-    filter.setMode(juce::dsp::LadderFilterMode::LPF24);
     lastOutputLevel = 0.0f; // [Safety] Ensure initialized
 }
 
 void Voice::prepare(double sr, int maxBlockSize) {
     sampleRate = sr;
+
+    // [Determinism] Seeded renders: fixed per-voice streams, set before dco.prepare() draws spread/drift
+    if (JunoRandom::isSeeded())
+        dco.setRandomSeed(JunoRandom::seedFor(JunoRandom::Stream::DCO, voiceIndex));
     dco.prepare(sr, maxBlockSize);
     
     juce::dsp::ProcessSpec spec;
@@ -20,23 +26,23 @@ void Voice::prepare(double sr, int maxBlockSize) {
     spec.numChannels = 1;
     
     adsr.setSampleRate(sr);
-    filter.prepare(spec);
-    filter.reset();
+    filter.prepare(sr);
     
+    // [Audit Fix] Coefficients are assigned before prepare() so the filter state is
+    // sized for 2nd order here, not lazily on the audio thread.
+    cachedHpfPosition = -1;
+    updateHPF();
     hpFilter.prepare(spec);
     hpFilter.reset();
-    updateHPF();
     
     resCompFilter.prepare(spec);
     resCompFilter.reset();
 
+    if (coefficientCache != nullptr)
+        hpfShelfFilter.coefficients = coefficientCache->shelf; // +2dB bump at 100Hz
     hpfShelfFilter.prepare(spec);
     hpfShelfFilter.reset(); 
-    hpfShelfFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sr, 100.0f, 0.707f, 1.25f); // +2dB bump at 100Hz
     
-    noiseColorFilter.prepare(spec);
-    noiseColorFilter.reset();
-    noiseColorFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(sr, 4000.0f, 0.707f, 0.707f); 
 
 
     smoothedCutoff.reset(sr, 0.02);
@@ -48,6 +54,7 @@ void Voice::prepare(double sr, int maxBlockSize) {
     thermalDrift = 0.0f;
     thermalTarget = 0.0f;
     thermalCounter = 0;
+    currentCutoffHz = -1.0f;
 
     tempBuffer.setSize(1, maxBlockSize);
 }
@@ -57,6 +64,9 @@ void Voice::noteOn(int midiNote, float vel, bool isLegato) {
     velocity = vel;
     isGateOn = true;
     lastOutputLevel = 1.0f;
+    tailPeak.reset(1.0f);
+    shedGain = 1.0f; // A shed voice can be stolen mid-fade
+    shedStep = 0.0f;
     
         // [Audit Fix] Note-based (Exponential Frequency) Portamento
         targetNote = static_cast<float>(midiNote);
@@ -77,16 +87,8 @@ void Voice::noteOn(int midiNote, float vel, bool isLegato) {
     
     bool shouldGlide = runGlide;
     
-    adsr.setSampleRate(sampleRate);
     // [ENV Audit] Set simplified, linear times. The ADSR class now handles the exponential curve.
-    // [Fidelidad] Exponential slider mapping for ADSR times
-    auto curveMap = [](float val, float minV, float maxV) {
-        return minV * std::pow(maxV / minV, val);
-    };
-    adsr.setAttack(curveMap(params.attack, Curves::kAttackMin, Curves::kAttackMax));
-    adsr.setDecay(curveMap(params.decay, Curves::kDecayMin, Curves::kDecayMax));
-    adsr.setSustain(params.sustain);
-    adsr.setRelease(curveMap(params.release, Curves::kReleaseMin, Curves::kReleaseMax));
+    applyEnvelopeCurves(params);
     
     if (!isLegato) {
         // [Fidelidad] Fix "Ataques Sordos" (Dull Attacks)
@@ -98,6 +100,7 @@ void Voice::noteOn(int midiNote, float vel, bool isLegato) {
         adsr.reset(); 
         adsr.noteOn();
         dco.reset(); 
+        currentCutoffHz = -1.0f; // Cutoff ramp restarts at the new note's target
         
         if (wasIdle) {
             // [Fix] Reset the filter only when starting from silence 
@@ -121,7 +124,36 @@ void Voice::forceStop() {
     adsr.reset(); 
     currentNote = -1; 
     lastOutputLevel = 0.0f; 
+    tailPeak.reset();
     currentFrequency = targetFrequency; // Reset portamento history
+    shedGain = 1.0f;
+    shedStep = 0.0f;
+}
+
+float Voice::predictTailLevel() const {
+    // Only a released ADSR envelope has a predictable decay; GATE mode releases in ~2ms anyway
+    if (isGateOn || isShedding() || params.vcaMode == 1 || adsr.getCurrentStage() != JunoADSR::Stage::Release)
+        return std::numeric_limits<float>::max();
+
+    // [Fidelidad] 8-bit envelope DAC: below one step the VCA is shut and the voice is silent
+    const float dac = std::floor(adsr.getCurrentValue() * 255.99f) / 255.0f;
+    if (dac <= 0.0f) return 0.0f;
+
+    // An inverted envelope opens the VCF as it falls: the output per envelope step can grow
+    if (params.vcfPolarity == 1 && params.envAmount > 0.0f) return std::numeric_limits<float>::max();
+
+    // The VCA is linear in the envelope, so the recent output per DAC step carries over. A normal
+    // envelope only closes the VCF further; LFO sweeps may open it by up to lfoToVCF * 4 octaves (~6dB each).
+    // [Fix] The peak spans a whole period: one chunk of a low note can catch a quiet part of the wave
+    const float nextDac = std::floor(adsr.getCurrentValue() * adsr.getReleaseRate() * 255.99f) / 255.0f;
+    const float vcaRise = smoothedVCALevel.getTargetValue() / juce::jmax(0.001f, smoothedVCALevel.getCurrentValue());
+    return tailPeak.get() / dac * nextDac * juce::jmax(1.0f, vcaRise) * std::exp2(params.lfoToVCF * 4.0f);
+}
+
+void Voice::shed(int fadeSamples) {
+    if (!isActive() || isShedding()) return;
+    shedStep = 1.0f / (float)juce::jmax(1, fadeSamples);
+    isGateOn = false;
 }
 
 /* Original noteOff implementation preserved */
@@ -130,26 +162,31 @@ void Voice::noteOff() {
     adsr.noteOff();
 }
 
-void Voice::updateParams(const SynthParams& p) {
+void Voice::updateParams(const SynthParams& p, juce::uint32 dirty) {
     params = p;
-    smoothedCutoff.setTargetValue(params.vcfFreq);
-    smoothedResonance.setTargetValue(params.resonance);
+    if (dirty & SynthParamDirty::Vcf) {
+        smoothedCutoff.setTargetValue(params.vcfFreq);
+        smoothedResonance.setTargetValue(params.resonance);
+    }
     
     // [VCA Audit] VCA level is now a master gain control for the voice
-    smoothedVCALevel.setTargetValue(params.vcaLevel);
+    if (dirty & SynthParamDirty::Vca) smoothedVCALevel.setTargetValue(params.vcaLevel);
     
-    dco.setRange(static_cast<JunoDCO::Range>(p.dcoRange));
-    dco.setSawLevel(p.sawOn ? 1.0f : 0.0f); 
-    dco.setPulseLevel(p.pulseOn ? 1.0f : 0.0f); 
-    dco.setSubLevel(p.subOscLevel);
-    dco.setNoiseLevel(p.noiseLevel);
-    dco.setPWM(p.pwmAmount);
-    dco.setPWMMode(static_cast<JunoDCO::PWMMode>(p.pwmMode));
-    dco.setLFODepth(p.lfoToDCO);
+    if (dirty & SynthParamDirty::Dco) {
+        dco.setRange(static_cast<JunoDCO::Range>(p.dcoRange));
+        dco.setSawLevel(p.sawOn ? 1.0f : 0.0f); 
+        dco.setPulseLevel(p.pulseOn ? 1.0f : 0.0f); 
+        dco.setSubLevel(p.subOscLevel);
+        dco.setNoiseLevel(p.noiseLevel);
+        dco.setPWM(p.pwmAmount);
+        dco.setPWMMode(static_cast<JunoDCO::PWMMode>(p.pwmMode));
+        dco.setLFODepth(p.lfoToDCO);
+    }
     
     // [Audit Fix] Apply power curve to drift for better resolution in low values
-    float curvedDrift = std::pow(p.thermalDrift, 1.5f);
-    dco.setDrift(curvedDrift);
+    if (dirty & SynthParamDirty::Thermal) dco.setDrift(JunoCurveTables::thermalDrift(p.thermalDrift));
+    
+    if (!(dirty & (SynthParamDirty::Envelope | SynthParamDirty::Hpf))) return;
     
     // [Fidelidad] STRICT VCA MODE CONVENTION: 
     // vcaMode = 0 -> ENV (Controlled by ADSR)
@@ -159,41 +196,37 @@ void Voice::updateParams(const SynthParams& p) {
     // BUT we also need to tell ADSR how to behave if it handles gate internally.
     // 'setGateMode(true)' forces ADSR to output square gate.
     
-    auto curveMap = [](float val, float minV, float maxV) {
-        return minV * std::pow(maxV / minV, val);
-    };
-
-    if (p.vcaMode == 1) { // GATE MODE
-        adsr.setGateMode(true);
-    } else { // ENV MODE
-        adsr.setGateMode(false);
-        adsr.setAttack(curveMap(p.attack, Curves::kAttackMin, Curves::kAttackMax));
-        adsr.setDecay(curveMap(p.decay, Curves::kDecayMin, Curves::kDecayMax));
-        adsr.setSustain(p.sustain);
-        adsr.setRelease(curveMap(p.release, Curves::kReleaseMin, Curves::kReleaseMax));
+    if (dirty & SynthParamDirty::Envelope) {
+        if (p.vcaMode == 1) { // GATE MODE
+            adsr.setGateMode(true);
+        } else { // ENV MODE
+            adsr.setGateMode(false);
+            applyEnvelopeCurves(p);
+        }
     }
     
-    updateHPF();
+    if (dirty & SynthParamDirty::Hpf) updateHPF();
 }
 
-void Voice::updateHPF() {
-    switch (params.hpfFreq) {
-        case 0: // Position 0: [Fidelity] Bass Boost (+3dB @ 70Hz shelving)
-            hpFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sampleRate, HPF::kShelfFreq, 0.707f, std::pow(10.0f, HPF::kShelfGainDb / 20.0f));
-            break;
-        case 1: // Position 1: Bypass (All-pass)
-            hpFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeAllPass(sampleRate, 1000.0f);
-            break;
-        case 2: // Position 2: 225Hz
-            hpFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, HPF::kFreq2, 0.707f);
-            break;
-        case 3: // Position 3: 700Hz
-            hpFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, HPF::kFreq3, 0.707f);
-            break;
-        default:
-            hpFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeAllPass(sampleRate, 1000.0f);
-            break;
+void Voice::applyEnvelopeCurves(const SynthParams& p) {
+    adsr.setSustain(p.sustain);
+
+    // [Optimization] 7-bit panel curves come from JunoCurveTables: lookups, no pow/exp per block
+    if (envelopeRates != nullptr) {
+        adsr.setRates(envelopeRates->attackRate(p.attack), envelopeRates->decayRate(p.decay), envelopeRates->releaseRate(p.release));
+        return;
     }
+    const auto& curves = JunoCurveTables::get();
+    adsr.setAttack(curves.attackSeconds(p.attack));
+    adsr.setDecay(curves.decaySeconds(p.decay));
+    adsr.setRelease(curves.releaseSeconds(p.release));
+}
+
+void Voice::updateHPF() {
+    // [Audit Fix] Pointer swap from the prepared cache: no allocation on the audio thread
+    if (coefficientCache == nullptr || params.hpfFreq == cachedHpfPosition) return;
+    cachedHpfPosition = params.hpfFreq;
+    hpFilter.coefficients = coefficientCache->forPosition(params.hpfFreq);
 }
 
 void Voice::forceUpdate() {
@@ -209,23 +242,29 @@ void Voice::forceUpdate() {
     hpfShelfFilter.reset();
 }
 
-void Voice::renderNextBlock(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, const std::vector<float>& lfoBuffer, float neighborCrosstalk) {
+void Voice::renderNextBlock(float* bus, int numSamples, const std::vector<float>& lfoBuffer, float neighborCrosstalk) {
     if (!(adsr.isActive() || lastOutputLevel > 0.0001f)) return;
+    jassert(noiseBank != nullptr);
+    if (noiseBank == nullptr) return;
     
+    jassert(numSamples <= tempBuffer.getNumSamples()); // Callers render in chunks of the prepared size
     if (numSamples > tempBuffer.getNumSamples()) numSamples = tempBuffer.getNumSamples();
     
     float bendedFrequency = updatePitch(numSamples);
     dco.setFrequency(bendedFrequency);
+    // The sub-oscillator, an octave under the range, has the longest period of the mix
+    const float slowestHz = juce::jmax(1.0f, bendedFrequency * dco.getRangeMultiplier() * 0.5f);
+    tailWindowSamples = (int)std::ceil(sampleRate / slowestHz);
     
     float* voiceData = tempBuffer.getWritePointer(0);
     renderVoiceCycles(voiceData, numSamples, lfoBuffer, neighborCrosstalk);
-    processFinalOutput(buffer, startSample, numSamples, voiceData);
+    processFinalOutput(bus, numSamples, voiceData);
 }
 
 float Voice::updatePitch(int numSamples) {
     if (params.portamentoOn && std::abs(currentNoteSlew - targetNote) > 0.001f) {
         // [Audit Fix] Exponential mapping for Portamento Knob (better sensitivity)
-        float glideTime = std::pow(params.portamentoTime, 2.0f) * 5.0f; 
+        float glideTime = JunoCurveTables::get().portamentoSeconds(params.portamentoTime); 
         
         float glideCoeff = 1.0f - std::exp(-static_cast<float>(numSamples) /
                                (juce::jmax(0.001f, glideTime) * static_cast<float>(sampleRate)));
@@ -238,8 +277,8 @@ float Voice::updatePitch(int numSamples) {
     }
     
     float bendedFrequency = currentFrequency * std::pow(2.0f, params.tune / 1200.0f);
-    if (params.benderValue != 0.0f && params.benderToDCO > 0.0f) {
-        bendedFrequency *= std::pow(2.0f, params.benderValue * (params.benderToDCO * 2.0f / 12.0f));
+    if (params.bendCV() != 0.0f && params.benderToDCO > 0.0f) {
+        bendedFrequency *= std::pow(2.0f, params.bendCV() * (params.benderToDCO * 2.0f / 12.0f));
     }
 
     // [Senior Audit] Global Thermal Drift (Shared DAC)
@@ -248,88 +287,144 @@ float Voice::updatePitch(int numSamples) {
 }
 
 void Voice::renderVoiceCycles(float* voiceData, int numSamples, const std::vector<float>& lfoBuffer, float neighborCrosstalk) {
+    // [Optimization] The panel switches are constant for the block: pick a specialised kernel once.
+    // Common waveform mixes get their own DCO code; the rest (noise, silent DCO) go through the
+    // DCO's own per-mask dispatch.
+    using D = JunoDCO;
+    switch (dco.getWaveMask()) {
+        case D::kSawBit | D::kPulseBit:             renderWithWaves<D::kSawBit | D::kPulseBit>(voiceData, numSamples, lfoBuffer.data(), neighborCrosstalk); break;
+        case D::kSawBit:                            renderWithWaves<D::kSawBit>(voiceData, numSamples, lfoBuffer.data(), neighborCrosstalk); break;
+        case D::kPulseBit:                          renderWithWaves<D::kPulseBit>(voiceData, numSamples, lfoBuffer.data(), neighborCrosstalk); break;
+        case D::kSawBit | D::kSubBit:               renderWithWaves<D::kSawBit | D::kSubBit>(voiceData, numSamples, lfoBuffer.data(), neighborCrosstalk); break;
+        case D::kPulseBit | D::kSubBit:             renderWithWaves<D::kPulseBit | D::kSubBit>(voiceData, numSamples, lfoBuffer.data(), neighborCrosstalk); break;
+        case D::kSawBit | D::kPulseBit | D::kSubBit: renderWithWaves<D::kSawBit | D::kPulseBit | D::kSubBit>(voiceData, numSamples, lfoBuffer.data(), neighborCrosstalk); break;
+        default:                                    renderWithWaves<kAnyWaves>(voiceData, numSamples, lfoBuffer.data(), neighborCrosstalk); break;
+    }
+}
+
+template <unsigned Waves>
+void Voice::renderWithWaves(float* voiceData, int numSamples, const float* lfo, float neighborCrosstalk) {
+    // HPF on the summed bus (processor) leaves the voice without one
+    const int hpf = params.busHpf ? kHpfOnBus : (params.hpfFreq == 0 ? kHpfWithShelf : kHpfOnly);
+    if (params.vcaMode == 1) renderWithHpf<Waves, true>(hpf, voiceData, numSamples, lfo, neighborCrosstalk);
+    else                     renderWithHpf<Waves, false>(hpf, voiceData, numSamples, lfo, neighborCrosstalk);
+}
+
+template <unsigned Waves, bool GateMode>
+void Voice::renderWithHpf(int hpf, float* voiceData, int numSamples, const float* lfo, float neighborCrosstalk) {
+    switch (hpf) {
+        case kHpfOnBus:     renderKernel<Waves, GateMode, kHpfOnBus>(voiceData, numSamples, lfo, neighborCrosstalk); break;
+        case kHpfWithShelf: renderKernel<Waves, GateMode, kHpfWithShelf>(voiceData, numSamples, lfo, neighborCrosstalk); break;
+        default:            renderKernel<Waves, GateMode, kHpfOnly>(voiceData, numSamples, lfo, neighborCrosstalk); break;
+    }
+}
+
+template <unsigned Waves, bool GateMode, int HpfStage>
+void Voice::renderKernel(float* voiceData, int numSamples, const float* lfoBuffer, float neighborCrosstalk) {
     float resParam = smoothedResonance.getNextValue();
-    filter.setResonance(juce::jlimit(0.0f, 0.99f, resParam)); 
-    filter.setDrive(1.0f + resParam * 1.2f); 
+    // [Enrichment] Analog Saturation: Gentle drive to add harmonics
+    filter.setDrive(1.35f + (params.resonance * 0.15f)); // Drive increases slightly with resonance
+
+    // Block-constant part of the cutoff CV: keyboard tracking, bender, thermal drift (octaves)
+    const float staticModOct = (params.kybdTracking > 0.001f ? ((static_cast<float>(currentNote) - 60.0f) * params.kybdTracking) / 12.0f : 0.0f)
+                             + (params.bendCV() * params.benderToVCF * 2.0f)
+                             + (thermalDrift / 1200.0f);
+    // VCF Modulation Mapping (Approx 5 octaves); polarity folded into the depth
+    const float envDepthOct = ((params.vcfPolarity == 1) ? -5.0f : 5.0f) * params.envAmount;
+    const float lfoDepthOct = params.lfoToVCF * 4.0f;
+    // [Fidelity] Resonance-compensated VCA Gain
+    // Moog-style/Juno ladders thin out at high resonance. We compensate slightly.
+    const float resComp = 1.0f + (resParam * resParam * 0.5f);
+    const float gateLevel = isGateOn ? 1.0f : 0.0f;
+    const float crosstalk = neighborCrosstalk * kVoiceCrosstalkAmount;
+    // [Fidelidad] Shared noise source: coloured DCO noise + this voice's decorrelated ripple slice
+    const float* noise = noiseBank->getNoise();
+    const float* ripple = noiseBank->getRipple(voiceIndex);
+    float envBuffer[kControlInterval];
+    const auto& curves = JunoCurveTables::get();
+
+    for (int pos = 0; pos < numSamples; pos += kControlInterval) {
+        const int seg = juce::jmin(kControlInterval, numSamples - pos);
+
+        // --- Control rate (once per segment, like the 8031 servicing the CV DAC) ---
+        // The envelope itself only moves on its 3ms MCU tick
+        for (int s = 0; s < seg; ++s) envBuffer[s] = adsr.getNextSample();
+        const float envVal = envBuffer[seg - 1];
+        const float voiceLfo = lfoBuffer[pos + seg - 1];
 
-    for (int i = 0; i < numSamples; ++i) {
-        float envVal = adsr.getNextSample();
-        float voiceLfo = lfoBuffer[i];
-        
-        // 1. DCO
-        float dcoSample = dco.getNextSample(voiceLfo);
-        float rippleNoise = (noiseGen.nextFloat() - 0.5f) * 0.0005f * envVal;
-        
-        // Soft-clipper (DCO Mixer saturation)
-        if (std::abs(dcoSample) > kDcoMixerSaturationThreshold) {
-             float x = dcoSample * 1.15f;
-             dcoSample = x - (x * x * x) / 24.0f; 
-        }
-        
-        float signal = dcoSample + neighborCrosstalk * kVoiceCrosstalkAmount + rippleNoise;
-        
-        // 2. VCF (Per-Sample Modulation for High Fidelity)
-        float vcfParam = smoothedCutoff.getNextValue();
         // [Fidelity] Refined VCF Curve: Target 20kHz at max, but more "open" in mid-range (exponent 0.65)
-        float baseCutoff = 10.0f * std::pow(2000.0f, std::pow(vcfParam, 0.65f));
+        const float vcfParam = smoothedCutoff.skip(seg);
+        const float baseCutoff = curves.cutoffHz(vcfParam);
         
-        if (params.kybdTracking > 0.001f) {
-             float semitones = static_cast<float>(currentNote) - 60.0f;
-             baseCutoff *= std::pow(2.0f, (semitones * params.kybdTracking) / 12.0f);
-        }
-        
-        // VCF Modulation Mapping (Approx 5 octaves)
-        float envMod = (params.vcfPolarity == 1) ? -envVal : envVal;
-        float finalModOct = (envMod * params.envAmount * 5.0f) + 
-                            (voiceLfo * params.lfoToVCF * 4.0f) + 
-                            (params.benderValue * params.benderToVCF * 2.0f);
-                            
-        // [Fidelity] Apply thermal drift to cutoff (approx +/- 20 cents)
-        float targetCutoff = baseCutoff * std::pow(2.0f, finalModOct + (thermalDrift / 1200.0f));
-        filter.setCutoffFrequencyHz(juce::jlimit(8.0f, static_cast<float>(sampleRate * 0.48), targetCutoff));
-        
-        // [Enrichment] Analog Saturation: Gentle drive to add harmonics
-        filter.setResonance(smoothedResonance.getNextValue());
-        filter.setDrive(1.35f + (params.resonance * 0.15f)); // Drive increases slightly with resonance
-        
-        // VCF Processing
-        float* signalPtr = &signal;
-        juce::dsp::AudioBlock<float> sampleBlock (&signalPtr, 1, 1);
-        juce::dsp::ProcessContextReplacing<float> vcfContext (sampleBlock);
-        filter.process (vcfContext);
-        
-        // 3. HPF [Audit Fix] Applied AFTER LPF for authentic Juno-106 routing
-        signal = hpFilter.processSample(signal);
-        if (params.hpfFreq == 0) signal = hpfShelfFilter.processSample(signal);
-        
-        // 4. VCA
-        float rawVcaLev = smoothedVCALevel.getNextValue();
-        
-        // [Fidelity] Resonance-compensated VCA Gain
-        // Moog-style/Juno ladders thin out at high resonance. We compensate slightly.
-        float resComp = 1.0f + (resParam * resParam * 0.5f);
-        float vcaGain = (params.vcaMode == 1) ? (rawVcaLev * (isGateOn ? 1.0f : 0.0f)) : (envVal * rawVcaLev);
+        const float finalModOct = (envVal * envDepthOct) + (voiceLfo * lfoDepthOct) + staticModOct;
+        const float targetCutoff = baseCutoff * std::exp2(finalModOct);
+
+        // Audio-rate kernels get an exponential (constant octaves/sample) ramp to the new target
+        if (currentCutoffHz <= 0.0f) currentCutoffHz = targetCutoff; // Voice start: no sweep from stale state
+        const float cutoffStep = std::exp2(std::log2(targetCutoff / currentCutoffHz) / (float)seg);
+
+        for (int s = 0; s < seg; ++s) {
+            const int i = pos + s;
+            const float envSample = envBuffer[s];
+            
+            // 1. DCO
+            float dcoSample;
+            if constexpr (Waves == kAnyWaves) dcoSample = dco.getNextSample(lfoBuffer[i], noise[i]);
+            else                              dcoSample = dco.renderSample<Waves>(lfoBuffer[i], noise[i]);
+            float rippleNoise = ripple[i] * 0.00025f * envSample; // Was (rand - 0.5) * 0.0005
+            
+            // Soft-clipper (DCO Mixer saturation)
+            if (std::abs(dcoSample) > kDcoMixerSaturationThreshold) {
+                 float x = dcoSample * 1.15f;
+                 dcoSample = x - (x * x * x) / 24.0f; 
+            }
+            
+            float signal = dcoSample + crosstalk + rippleNoise;
+            
+            // 2. VCF (cutoff ramps per sample; no coefficient rebuilds, no transcendental math)
+            currentCutoffHz *= cutoffStep;
+            signal = filter.processSample(signal, currentCutoffHz, smoothedResonance.getNextValue());
         
-        // Final Output
-        voiceData[i] = signal * vcaGain * resComp * kVoiceOutputGain;
+            // 3. HPF [Audit Fix] Applied AFTER LPF for authentic Juno-106 routing (legacy per-voice mode)
+            if constexpr (HpfStage != kHpfOnBus) signal = hpFilter.processSample(signal);
+            if constexpr (HpfStage == kHpfWithShelf) signal = hpfShelfFilter.processSample(signal);
+            
+            // 4. VCA
+            const float rawVcaLev = smoothedVCALevel.getNextValue();
+            const float vcaGain = GateMode ? (rawVcaLev * gateLevel) : (envSample * rawVcaLev);
+            
+            // Final Output
+            voiceData[i] = signal * vcaGain * resComp * kVoiceOutputGain;
+        }
     }
 }
 
-void Voice::processFinalOutput(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, float* voiceData) {
+void Voice::processFinalOutput(float* bus, int numSamples, const float* voiceData) {
     float currentBlockMax = 0.0f;
     for (int i = 0; i < numSamples; ++i) {
         float sample = voiceData[i];
         if (std::isnan(sample) || std::isinf(sample)) sample = 0.0f;
         sample = std::tanh(sample * 1.0f);
+        if (shedStep > 0.0f) {
+            sample *= shedGain;
+            shedGain = juce::jmax(0.0f, shedGain - shedStep);
+        }
         
         float absSample = std::abs(sample);
         if (absSample > currentBlockMax) currentBlockMax = absSample;
 
-        buffer.addSample(0, startSample + i, sample);
-        if (buffer.getNumChannels() > 1) buffer.addSample(1, startSample + i, sample);
+        bus[i] += sample;
     }
     
     lastOutputLevel = currentBlockMax;
+    tailPeak.push(currentBlockMax, numSamples, tailWindowSamples);
+
+    // Shed voice: stop once the fade has reached silence
+    if (shedStep > 0.0f && shedGain <= 0.0f) {
+        forceStop();
+        isGateOn = false;
+        return;
+    }
     
     // [Fidelity] "Voice Kill" threshold (~0.4%)
     if (!adsr.isActive() && lastOutputLevel < kVoiceKillThreshold) {
@@ -339,6 +434,7 @@ void Voice::processFinalOutput(juce::AudioBuffer<float>& buffer, int startSample
 }
 
 void Voice::setBender(float v) { params.benderValue = v; }
+void Voice::setThermalDrift(float drift, float curvedDrift) { params.thermalDrift = drift; dco.setDrift(curvedDrift); }
 void Voice::setPortamentoEnabled(bool b) { params.portamentoOn = b; }
 void Voice::setPortamentoTime(float v) { params.portamentoTime = v; }
 void Voice::setPortamentoLegato(bool b) { params.portamentoLegato = b; }
@@ -5,6 +5,11 @@
 #include <algorithm>
 #include "JunoDCO.h"
 #include "JunoADSR.h"
+#include "JunoVCF.h"
+#include "JunoHPFCoefficients.h"
+#include "JunoCurveTables.h"
+#include "JunoNoiseBank.h"
+#include "JunoPeakHold.h"
 #include "../Core/SynthParams.h"
 
 /**
@@ -19,26 +24,33 @@ public:
     void prepare(double sampleRate, int maxBlockSize);
     
     // The voice now processes a buffer containing the GLOBAL LFO signal
-    void renderNextBlock(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, const std::vector<float>& lfoBuffer, float neighborCrosstalk);
+    void renderNextBlock(float* bus, int numSamples, const std::vector<float>& lfoBuffer, float neighborCrosstalk); // Adds into a mono bus
     
     void noteOn(int midiNote, float velocity, bool isLegato);
     void noteOff();
     void forceStop();
+    void shed(int fadeSamples); // Load shedding: short linear fade, then forceStop()
     
     bool isActive() const { return currentNote != -1; }
+    bool isShedding() const { return shedStep > 0.0f; }
+    float predictTailLevel() const; // Level at the next envelope DAC step of the release (see JunoVoiceManager tail culling)
     int getCurrentNote() const { return currentNote; }
     bool isGateOnActive() const { return isGateOn; }
     float lastActiveOutputLevel() const { return lastOutputLevel; }
     
-    void updateParams(const SynthParams& params);
+    void updateParams(const SynthParams& params, juce::uint32 dirty = SynthParamDirty::All); // Rebuilds only the dirty groups
     void forceUpdate(); // [Fix] Instant parameter update (no smoothing) for patch load
     void updateHPF();
     
     void setBender(float v);
+    void setThermalDrift(float drift, float curvedDrift);
     void setPortamentoEnabled(bool b);
     void setPortamentoTime(float v);
     void setPortamentoLegato(bool b);
     void setVoiceIndex(int i) { voiceIndex = i; }
+    void setCoefficientCache(const JunoHPFCoefficients* cache) { coefficientCache = cache; }
+    void setEnvelopeRates(const JunoCurveTables::EnvelopeRates* rates) { envelopeRates = rates; }
+    void setNoiseBank(const JunoNoiseBank* bank) { noiseBank = bank; } // Rendered ahead of the voices
 
 private:
     // Components
@@ -46,11 +58,14 @@ private:
     // LFO has been removed from the voice; it's now global in PluginProcessor
     JunoADSR adsr;
     
-    juce::dsp::LadderFilter<float> filter;
+    JunoVCF filter;
     juce::dsp::IIR::Filter<float> hpFilter;
     juce::dsp::IIR::Filter<float> resCompFilter;
     juce::dsp::IIR::Filter<float> hpfShelfFilter;
-    juce::dsp::IIR::Filter<float> noiseColorFilter;
+    const JunoHPFCoefficients* coefficientCache = nullptr; // Owned by JunoVoiceManager
+    const JunoCurveTables::EnvelopeRates* envelopeRates = nullptr; // Owned by JunoVoiceManager
+    const JunoNoiseBank* noiseBank = nullptr; // Owned by JunoVoiceManager
+    int cachedHpfPosition = -1;
     
     // Smoothing
     juce::LinearSmoothedValue<float> smoothedCutoff;
@@ -63,12 +78,20 @@ private:
     float velocity = 0.0f;
     float currentFrequency = 440.0f;
     float targetFrequency = 440.0f;
+    float targetNote = 69.0f;
+    float currentNoteSlew = 69.0f; // Portamento runs in the note domain
     
     bool isGateOn = false;
     float lastOutputLevel = 0.0f;
+    JunoPeakHold tailPeak;      // Output peak over >= one sub-oscillator period (predictTailLevel)
+    int tailWindowSamples = 0;
+    float shedGain = 1.0f;  // Fade applied while shed (JunoVoiceManager CPU governor)
+    float shedStep = 0.0f;  // Per-sample decrement, 0 = not shedding
     float lastModOctaves = 0.0f;
+    float currentCutoffHz = -1.0f; // Per-sample cutoff ramp (<= 0: snap to the next target)
+
+    static constexpr int kControlInterval = 32; // Samples per control-rate update (cutoff CV)
     uint8_t lastEnvByte = 0;
-    juce::Random noiseGen;
     
     float thermalDrift = 0.0f;   // [Fidelidad] Independent voice heat
     float thermalTarget = 0.0f;
@@ -79,6 +102,22 @@ private:
 
     SynthParams params;
     juce::AudioBuffer<float> tempBuffer;
+
+    // Render stages
+    float updatePitch(int numSamples);
+    void applyEnvelopeCurves(const SynthParams& p);
+    void renderVoiceCycles(float* voiceData, int numSamples, const std::vector<float>& lfoBuffer, float neighborCrosstalk); // Kernel dispatch
+
+    // [Optimization] Render kernels specialised on the block-constant panel switches
+    static constexpr unsigned kAnyWaves = JunoDCO::kNumWaveMasks; // Waveform mix resolved by the DCO per sample
+    enum HpfStage { kHpfOnBus = 0, kHpfOnly, kHpfWithShelf }; // Per-voice HPF work (none when on the bus)
+    template <unsigned Waves>
+    void renderWithWaves(float* voiceData, int numSamples, const float* lfo, float neighborCrosstalk);
+    template <unsigned Waves, bool GateMode>
+    void renderWithHpf(int hpf, float* voiceData, int numSamples, const float* lfo, float neighborCrosstalk);
+    template <unsigned Waves, bool GateMode, int HpfStage>
+    void renderKernel(float* voiceData, int numSamples, const float* lfo, float neighborCrosstalk);
+    void processFinalOutput(float* bus, int numSamples, const float* voiceData);
     
     // [Fix] Removed releaseCounter/timeout - Allow natural envelope decay
     // int releaseCounter = 0;
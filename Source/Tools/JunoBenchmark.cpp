@@ -0,0 +1,378 @@
+// Source/Tools/JunoBenchmark.cpp
+#include <JuceHeader.h>
+#include <iostream>
+#include <chrono>
+#include "../Core/PluginProcessor.h"
+#include "../Core/JunoBBD.h"
+#include "../Core/JunoRandom.h"
+#include "../Synth/JunoADSR.h"
+#include "../Synth/JunoDCO.h"
+#include "../Synth/Voice.h"
+
+/**
+ * JunoBenchmark - Micro and macro benchmarks for the DSP hot paths
+ *
+ * Micro: JunoDCO (every waveform combination), JunoADSR, JunoBBD, Voice, master LFO.
+ * Macro: full processBlock at 1/6/16 held voices (plus the whole pool when --pool > 16)
+ * x 32/128/512/2048-sample blocks,
+ * the per-object engine at 16 voices rendered serially vs on the worker pool, and an
+ * 8-part multitimbral rig (2 voices per MIDI channel) with shared vs per-part chorus.
+ *
+ * Each case reports the best of several timed runs as ns/sample. Voice cases also
+ * report voices-per-core: how many voices one core could render in realtime.
+ * Output is JSON (stdout, or --out=<file>). --quick shortens every run for CI smoke tests.
+ * --pool=<n> sizes the voice pool of every processor (default JUNO_VOICE_POOL_SIZE).
+ */
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr double kSampleRate = 48000.0;
+
+    struct BenchConfig {
+        double secondsPerRun = 1.0; // Audio seconds rendered per timed run
+        int runs = 5;
+        int poolSize = JUNO_VOICE_POOL_SIZE;
+    };
+
+    struct Result {
+        juce::String name;
+        double nsPerSample = 0.0;
+        int voices = 0;        // 0 = not a voice-level case
+        int blockSize = 0;
+    };
+
+    // Keeps the optimiser from discarding benchmark loops
+    volatile float sink = 0.0f;
+
+    /** Times body(numSamples) over cfg.runs runs and returns the best ns/sample. */
+    template <typename Body>
+    double timeBest(const BenchConfig& cfg, juce::int64 numSamples, Body&& body) {
+        body(juce::jmin<juce::int64>(numSamples, 4096)); // Warm-up
+        double best = 1.0e30;
+        for (int r = 0; r < cfg.runs; ++r) {
+            const auto t0 = Clock::now();
+            body(numSamples);
+            const auto t1 = Clock::now();
+            const double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+            best = juce::jmin(best, ns / (double)numSamples);
+        }
+        return best;
+    }
+
+    juce::int64 samplesPerRun(const BenchConfig& cfg) { return (juce::int64)(cfg.secondsPerRun * kSampleRate); }
+
+    //==============================================================================
+    void benchDCO(const BenchConfig& cfg, std::vector<Result>& results) {
+        static const char* names[] = { "saw", "pulse", "sub", "noise" };
+
+        for (int combo = 1; combo < 16; ++combo) {
+            JunoDCO dco;
+            dco.prepare(kSampleRate, 512);
+            dco.setFrequency(220.0f);
+            dco.setSawLevel((combo & 1) ? 1.0f : 0.0f);
+            dco.setPulseLevel((combo & 2) ? 1.0f : 0.0f);
+            dco.setSubLevel((combo & 4) ? 1.0f : 0.0f);
+            dco.setNoiseLevel((combo & 8) ? 1.0f : 0.0f);
+            dco.setDrift(0.5f);
+
+            juce::String name = "JunoDCO::getNextSample/";
+            for (int b = 0; b < 4; ++b)
+                if (combo & (1 << b)) name << (name.endsWithChar('/') ? "" : "+") << names[b];
+
+            const double ns = timeBest(cfg, samplesPerRun(cfg), [&dco](juce::int64 n) {
+                float acc = 0.0f;
+                for (juce::int64 i = 0; i < n; ++i) acc += dco.getNextSample(0.0f);
+                sink = acc;
+            });
+            results.push_back({ name, ns });
+        }
+    }
+
+    void benchADSR(const BenchConfig& cfg, std::vector<Result>& results) {
+        JunoADSR adsr;
+        adsr.setSampleRate(kSampleRate);
+        adsr.setAttack(0.01f);
+        adsr.setDecay(0.2f);
+        adsr.setSustain(0.6f);
+        adsr.setRelease(0.3f);
+
+        const double ns = timeBest(cfg, samplesPerRun(cfg), [&adsr](juce::int64 n) {
+            float acc = 0.0f;
+            for (juce::int64 i = 0; i < n; ++i) {
+                if ((i & 0x7FFF) == 0) adsr.noteOn();          // Cycle through every stage
+                else if ((i & 0x7FFF) == 0x4000) adsr.noteOff();
+                acc += adsr.getNextSample();
+            }
+            sink = acc;
+        });
+        results.push_back({ "JunoADSR::getNextSample", ns });
+    }
+
+    void benchBBD(const BenchConfig& cfg, std::vector<Result>& results) {
+        JunoDSP::JunoBBD bbd;
+        bbd.prepare({ kSampleRate, 512, 1 });
+
+        const double ns = timeBest(cfg, samplesPerRun(cfg), [&bbd](juce::int64 n) {
+            float acc = 0.0f, phase = 0.0f;
+            for (juce::int64 i = 0; i < n; ++i) {
+                phase += 0.5f / (float)kSampleRate;
+                if (phase >= 1.0f) phase -= 1.0f;
+                const float lfo = 2.0f * std::abs(2.0f * (phase - 0.5f)) - 1.0f;
+                acc += bbd.processSample((float)(i & 63) * 0.01f, 3.2f + lfo * 1.8f);
+            }
+            sink = acc;
+        });
+        results.push_back({ "JunoBBD::processSample", ns });
+
+        constexpr int blockSize = 512;
+        JunoDSP::JunoBBD blockBbd;
+        blockBbd.prepare({ kSampleRate, (juce::uint32)blockSize, 1 });
+        std::vector<float> in((size_t)blockSize), delays((size_t)blockSize), out((size_t)blockSize);
+        for (int i = 0; i < blockSize; ++i) in[(size_t)i] = (float)(i & 63) * 0.01f;
+
+        const double nsBlock = timeBest(cfg, samplesPerRun(cfg), [&](juce::int64 n) {
+            float phase = 0.0f;
+            for (juce::int64 pos = 0; pos < n; pos += blockSize) {
+                for (int i = 0; i < blockSize; ++i) {
+                    phase += 0.5f / (float)kSampleRate;
+                    if (phase >= 1.0f) phase -= 1.0f;
+                    const float lfo = 2.0f * std::abs(2.0f * (phase - 0.5f)) - 1.0f;
+                    delays[(size_t)i] = (3.2f + lfo * 1.8f) * 0.001f * (float)kSampleRate;
+                }
+                blockBbd.processBlock(in.data(), delays.data(), out.data(), blockSize);
+            }
+            sink = out[0];
+        });
+        results.push_back({ "JunoBBD::processBlock", nsBlock, 0, blockSize });
+    }
+
+    void benchVoice(const BenchConfig& cfg, std::vector<Result>& results) {
+        constexpr int blockSize = 512;
+        JunoHPFCoefficients coeffs;
+        coeffs.prepare(kSampleRate);
+
+        JunoNoiseBank noise;
+        noise.prepare(kSampleRate, blockSize, 1);
+
+        Voice voice;
+        voice.setCoefficientCache(&coeffs);
+        voice.setNoiseBank(&noise);
+        voice.prepare(kSampleRate, blockSize);
+        SynthParams params;
+        params.subOscLevel = 0.5f;
+        params.resonance = 0.3f;
+        voice.updateParams(params);
+        voice.forceUpdate();
+
+        std::vector<float> bus((size_t)blockSize, 0.0f);
+        std::vector<float> lfo((size_t)blockSize, 0.0f);
+
+        const double ns = timeBest(cfg, samplesPerRun(cfg), [&](juce::int64 n) {
+            for (juce::int64 pos = 0; pos < n; pos += blockSize) {
+                if (!voice.isActive()) voice.noteOn(48, 1.0f, false);
+                std::fill(bus.begin(), bus.end(), 0.0f);
+                noise.renderBlock(blockSize, false);
+                voice.renderNextBlock(bus.data(), blockSize, lfo, 0.0f);
+            }
+            sink = bus[0];
+        });
+        results.push_back({ "Voice::renderNextBlock", ns, 1, blockSize });
+    }
+
+    void benchMasterLfo(const BenchConfig& cfg, std::vector<Result>& results) {
+        constexpr int blockSize = 512;
+        SimpleJuno106AudioProcessor processor;
+        processor.setPlayConfigDetails(0, 2, kSampleRate, blockSize);
+        processor.prepareToPlay(kSampleRate, blockSize);
+
+        const double ns = timeBest(cfg, samplesPerRun(cfg), [&processor](juce::int64 n) {
+            constexpr int chunk = SimpleJuno106AudioProcessor::kRenderChunk; // lfoBuffer holds one render chunk
+            for (juce::int64 pos = 0; pos < n; pos += chunk)
+                processor.renderMasterLfo(chunk, 6.0f / (float)kSampleRate, 0.0001f, true);
+        });
+        results.push_back({ "PluginProcessor::renderMasterLfo", ns, 0, SimpleJuno106AudioProcessor::kRenderChunk });
+    }
+
+    void benchProcessBlock(const BenchConfig& cfg, std::vector<Result>& results) {
+        std::vector<int> voiceCounts;
+        for (int voices : { 1, 6, 16, cfg.poolSize })
+            if (voices <= cfg.poolSize && std::find(voiceCounts.begin(), voiceCounts.end(), voices) == voiceCounts.end())
+                voiceCounts.push_back(voices);
+
+        for (int voices : voiceCounts) {
+            for (int blockSize : { 32, 128, 512, 2048 }) {
+                SimpleJuno106AudioProcessor processor(cfg.poolSize);
+                processor.setPlayConfigDetails(0, 2, kSampleRate, blockSize);
+                processor.prepareToPlay(kSampleRate, blockSize);
+                processor.getVoiceManagerNC().setVoiceLimit(juce::jmax(voices, 6));
+
+                juce::AudioBuffer<float> buffer(2, blockSize);
+                juce::MidiBuffer midi, noMidi;
+                for (int v = 0; v < voices; ++v)
+                    midi.addEvent(juce::MidiMessage::noteOn(1, 36 + v * 3, (juce::uint8)100), 0);
+                buffer.clear();
+                processor.processBlock(buffer, midi); // Hold the chord for the whole run
+
+                const double ns = timeBest(cfg, samplesPerRun(cfg), [&](juce::int64 n) {
+                    for (juce::int64 pos = 0; pos < n; pos += blockSize) {
+                        buffer.clear();
+                        processor.processBlock(buffer, noMidi);
+                    }
+                    sink = buffer.getSample(0, 0);
+                });
+
+                juce::String name;
+                name << "processBlock/" << voices << "v/" << blockSize;
+                results.push_back({ name, ns, voices, blockSize });
+                processor.releaseResources();
+            }
+        }
+    }
+
+    void benchParallelVoices(const BenchConfig& cfg, std::vector<Result>& results) {
+        const int voices = juce::jmin(16, cfg.poolSize);
+        constexpr int blockSize = 512;
+        for (bool parallel : { false, true }) {
+            SimpleJuno106AudioProcessor processor(cfg.poolSize);
+            auto& vm = processor.getVoiceManagerNC();
+            vm.setRenderEngine(JunoVoiceManager::RenderEngine::VoiceObjects);
+            vm.setParallelRendering(parallel); // Before prepareToPlay: the pool starts there
+            processor.setPlayConfigDetails(0, 2, kSampleRate, blockSize);
+            processor.prepareToPlay(kSampleRate, blockSize);
+            vm.setVoiceLimit(voices);
+
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            juce::MidiBuffer midi, noMidi;
+            for (int v = 0; v < voices; ++v)
+                midi.addEvent(juce::MidiMessage::noteOn(1, 36 + v * 3, (juce::uint8)100), 0);
+            buffer.clear();
+            processor.processBlock(buffer, midi);
+
+            const double ns = timeBest(cfg, samplesPerRun(cfg), [&](juce::int64 n) {
+                for (juce::int64 pos = 0; pos < n; pos += blockSize) {
+                    buffer.clear();
+                    processor.processBlock(buffer, noMidi);
+                }
+                sink = buffer.getSample(0, 0);
+            });
+
+            juce::String name;
+            name << "processBlock/VoiceObjects/" << voices << "v/" << blockSize << (parallel ? "/parallel" : "/serial");
+            results.push_back({ name, ns, voices, blockSize });
+            processor.releaseResources();
+        }
+    }
+
+    void benchMultitimbral(const BenchConfig& cfg, std::vector<Result>& results) {
+        constexpr int numParts = 8;
+        constexpr int voicesPerPart = 2;
+        constexpr int blockSize = 512;
+        using Routing = SimpleJuno106AudioProcessor::ChorusRouting;
+        for (auto routing : { Routing::Shared, Routing::PerPart }) {
+            SimpleJuno106AudioProcessor processor(cfg.poolSize);
+            processor.setMultitimbral(numParts, routing, voicesPerPart); // Before prepareToPlay: parts allocate there
+            processor.setPlayConfigDetails(0, 2, kSampleRate, blockSize);
+            processor.prepareToPlay(kSampleRate, blockSize);
+
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            juce::MidiBuffer midi, noMidi;
+            for (int part = 0; part < numParts; ++part) {
+                SynthParams patch;
+                patch.chorus1 = (part % 2) == 0;
+                patch.chorus2 = (part % 3) == 0;
+                patch.vcfFreq = 0.4f + 0.05f * (float)part;
+                processor.setPartPatch(part + 1, patch);
+                for (int v = 0; v < voicesPerPart; ++v)
+                    midi.addEvent(juce::MidiMessage::noteOn(part + 1, 40 + part * 2 + v * 7, (juce::uint8)100), 0);
+            }
+            buffer.clear();
+            processor.processBlock(buffer, midi);
+
+            const double ns = timeBest(cfg, samplesPerRun(cfg), [&](juce::int64 n) {
+                for (juce::int64 pos = 0; pos < n; pos += blockSize) {
+                    buffer.clear();
+                    processor.processBlock(buffer, noMidi);
+                }
+                sink = buffer.getSample(0, 0);
+            });
+
+            juce::String name;
+            name << "processBlock/multitimbral/" << numParts << "x" << voicesPerPart << "v/" << blockSize
+                 << (routing == Routing::PerPart ? "/perPartChorus" : "/sharedChorus");
+            results.push_back({ name, ns, numParts * voicesPerPart, blockSize });
+            processor.releaseResources();
+        }
+    }
+
+    //==============================================================================
+    juce::var toJson(const std::vector<Result>& results, const BenchConfig& cfg) {
+        juce::Array<juce::var> cases;
+        for (const auto& r : results) {
+            juce::DynamicObject::Ptr o = new juce::DynamicObject();
+            o->setProperty("name", r.name);
+            o->setProperty("nsPerSample", r.nsPerSample);
+            if (r.blockSize > 0) o->setProperty("blockSize", r.blockSize);
+            if (r.voices > 0) {
+                // One core renders 1e9 ns of work per second; realtime needs sampleRate samples per voice
+                const double realtimeFactor = 1.0e9 / (r.nsPerSample * kSampleRate);
+                o->setProperty("voices", r.voices);
+                o->setProperty("realtimeFactor", realtimeFactor);
+                o->setProperty("voicesPerCore", realtimeFactor * r.voices);
+            }
+            cases.add(juce::var(o.get()));
+        }
+
+        juce::DynamicObject::Ptr root = new juce::DynamicObject();
+        root->setProperty("sampleRate", kSampleRate);
+        root->setProperty("secondsPerRun", cfg.secondsPerRun);
+        root->setProperty("runs", cfg.runs);
+        root->setProperty("voicePoolSize", cfg.poolSize);
+       #if JUNO_SIMD_VOICE_BANK
+        root->setProperty("renderEngine", "VoiceBank");
+       #else
+        root->setProperty("renderEngine", "VoiceObjects");
+       #endif
+        root->setProperty("cases", cases);
+        return juce::var(root.get());
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit; // APVTS and the processor expect a MessageManager
+    juce::ArgumentList args(argc, argv);
+    JunoRandom::setGlobalSeed(1); // Every run renders the same signal
+
+    BenchConfig cfg;
+    if (args.containsOption("--quick")) { cfg.secondsPerRun = 0.05; cfg.runs = 2; }
+    if (args.containsOption("--seconds")) cfg.secondsPerRun = juce::jmax(0.01, args.getValueForOption("--seconds").getDoubleValue());
+    if (args.containsOption("--runs")) cfg.runs = juce::jmax(1, args.getValueForOption("--runs").getIntValue());
+    if (args.containsOption("--pool"))
+        cfg.poolSize = juce::jlimit(1, JunoVoiceManager::kMaxPoolSize, args.getValueForOption("--pool").getIntValue());
+    const juce::String filter = args.getValueForOption("--filter"); // Substring match on case groups
+
+    std::vector<Result> results;
+    auto wants = [&filter](const char* group) { return filter.isEmpty() || juce::String(group).containsIgnoreCase(filter); };
+
+    if (wants("JunoDCO")) benchDCO(cfg, results);
+    if (wants("JunoADSR")) benchADSR(cfg, results);
+    if (wants("JunoBBD")) benchBBD(cfg, results);
+    if (wants("Voice")) benchVoice(cfg, results);
+    if (wants("MasterLfo")) benchMasterLfo(cfg, results);
+    if (wants("processBlock")) benchProcessBlock(cfg, results);
+    if (wants("processBlock/parallel")) benchParallelVoices(cfg, results);
+    if (wants("processBlock/multitimbral")) benchMultitimbral(cfg, results);
+
+    const auto json = juce::JSON::toString(toJson(results, cfg));
+    if (args.containsOption("--out")) {
+        auto file = args.getFileForOption("--out");
+        if (!file.replaceWithText(json)) {
+            std::cerr << "JunoBenchmark: cannot write " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+    } else {
+        std::cout << json << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,202 @@
+// Source/Tools/JunoEngineCheck.cpp
+#include <JuceHeader.h>
+#include <iostream>
+#include "../Core/PluginProcessor.h"
+#include "../Core/JunoRandom.h"
+
+/**
+ * JunoEngineCheck - Voice engine regression tests (CTest: engine_<case>)
+ *
+ * Each case drives the processor through processBlock, as a host would, for both
+ * render engines and checks what the voice manager reports. The load governor is
+ * kept out of the way by running non-realtime.
+ *
+ *   polyphony    - a chord as wide as the voice pool (more than 8 notes): every note sounds
+ *   multitimbral - 4 parts x 3 notes all sound; a part patch reaches the panel through the
+ *                  message thread (syncPanelToEditPart), never from processBlock
+ *   low_tail     - a low 16' note with the sub-oscillator and a long release, rendered seeded
+ *                  with and without tail culling: culling may only remove what is below the floor
+ *
+ * Usage: JunoEngineCheck --case=<name> [--sr=<hz>]
+ */
+namespace
+{
+    constexpr int kBlockSize = 512;
+
+    int fail(const juce::String& message) {
+        std::cerr << "JunoEngineCheck: " << message << std::endl;
+        return 1;
+    }
+
+    const char* engineName(JunoVoiceManager::RenderEngine engine) {
+        return engine == JunoVoiceManager::RenderEngine::VoiceBank ? "VoiceBank" : "VoiceObjects";
+    }
+
+    /** Processor prepared for offline rendering with the given engine. */
+    struct TestRig {
+        TestRig(int poolSize, JunoVoiceManager::RenderEngine engine, double sr, int numParts = 1) : processor(poolSize), sampleRate(sr) {
+            processor.getVoiceManagerNC().setRenderEngine(engine);
+            if (numParts > 1) processor.setMultitimbral(numParts); // Before prepareToPlay: parts allocate there
+            processor.setNonRealtime(true);
+            processor.setPlayConfigDetails(0, 2, sampleRate, kBlockSize);
+            processor.prepareToPlay(sampleRate, kBlockSize);
+        }
+        ~TestRig() { processor.releaseResources(); }
+
+        /** Renders the given time; midi lands at the start of the first block. Returns the output peak;
+            capture, when given, receives the left channel. */
+        float render(double seconds, juce::MidiBuffer midi = {}, std::vector<float>* capture = nullptr) {
+            float peak = 0.0f;
+            const auto numBlocks = (int)std::ceil(seconds * sampleRate / kBlockSize);
+            for (int b = 0; b < juce::jmax(1, numBlocks); ++b) {
+                buffer.clear();
+                processor.processBlock(buffer, midi);
+                midi.clear();
+                peak = juce::jmax(peak, buffer.getMagnitude(0, kBlockSize));
+                if (capture != nullptr) capture->insert(capture->end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + kBlockSize);
+            }
+            return peak;
+        }
+
+        void setParameter(const juce::String& id, float normalised) {
+            if (auto* p = processor.getAPVTS().getParameter(id)) p->setValueNotifyingHost(normalised);
+        }
+
+        SimpleJuno106AudioProcessor processor;
+        double sampleRate;
+        juce::AudioBuffer<float> buffer { 2, kBlockSize };
+    };
+
+    juce::Result checkPolyphony(JunoVoiceManager::RenderEngine engine, int poolSize, double sampleRate) {
+        TestRig rig(poolSize, engine, sampleRate);
+        const auto& vm = rig.processor.getVoiceManager();
+        const int numNotes = vm.getPoolSize();
+        if (vm.getVoiceLimit() != numNotes)
+            return juce::Result::fail("voice limit " + juce::String(vm.getVoiceLimit()) + " is not the pool size " + juce::String(numNotes));
+
+        juce::MidiBuffer chord;
+        for (int n = 0; n < numNotes; ++n)
+            chord.addEvent(juce::MidiMessage::noteOn(rig.processor.midiChannel, 36 + n, (juce::uint8)100), 0);
+        const float peak = rig.render(0.25, chord);
+
+        const int sounding = vm.getActiveVoiceCount();
+        std::cout << engineName(engine) << " pool " << numNotes << ": " << sounding << " of " << numNotes << " notes sounding" << std::endl;
+        if (sounding != numNotes) return juce::Result::fail(juce::String(numNotes - sounding) + " note(s) got no voice");
+        if (peak <= 0.0f) return juce::Result::fail("the chord rendered silence");
+        return juce::Result::ok();
+    }
+
+    juce::Result runPolyphony(double sampleRate) {
+        for (auto engine : { JunoVoiceManager::RenderEngine::VoiceBank, JunoVoiceManager::RenderEngine::VoiceObjects }) {
+            for (int poolSize : { JUNO_VOICE_POOL_SIZE, 32 }) { // The plugin's pool, and a larger one
+                const auto result = checkPolyphony(engine, poolSize, sampleRate);
+                if (result.failed()) return juce::Result::fail(juce::String(engineName(engine)) + ": " + result.getErrorMessage());
+            }
+        }
+        return juce::Result::ok();
+    }
+
+    juce::Result runMultitimbral(double sampleRate) {
+        constexpr int numParts = 4, notesPerPart = 3;
+        TestRig rig(16, JunoVoiceManager::RenderEngine::VoiceObjects, sampleRate, numParts);
+        auto& processor = rig.processor;
+        const auto& vm = processor.getVoiceManager();
+
+        juce::MidiBuffer notes;
+        for (int part = 0; part < numParts; ++part)
+            for (int n = 0; n < notesPerPart; ++n)
+                notes.addEvent(juce::MidiMessage::noteOn(part + 1, 48 + n * 4, (juce::uint8)100), 0);
+        rig.render(0.1, notes);
+
+        std::cout << "Parts: " << vm.getActiveVoiceCount() << " of " << numParts * notesPerPart << " notes sounding" << std::endl;
+        for (int part = 0; part < numParts; ++part)
+            if (vm.getActiveVoiceCount(part) != notesPerPart)
+                return juce::Result::fail("part " + juce::String(part + 1) + " sounds " + juce::String(vm.getActiveVoiceCount(part))
+                                          + " of " + juce::String(notesPerPart) + " notes");
+
+        // A new patch for the edit part: the audio thread only asks, the panel moves on the message thread
+        auto* cutoff = processor.getAPVTS().getRawParameterValue("vcfFreq");
+        SynthParams patch = processor.getMirrorParameters();
+        patch.vcfFreq = cutoff->load() > 0.5f ? 0.25f : 0.75f;
+        processor.setPartPatch(processor.midiChannel, patch);
+        rig.render(0.01);
+        if (std::abs(cutoff->load() - patch.vcfFreq) < 1.0e-3f) return juce::Result::fail("processBlock loaded the panel");
+        processor.syncPanelToEditPart();
+        if (std::abs(cutoff->load() - patch.vcfFreq) > 1.0e-3f) return juce::Result::fail("the panel did not load the edit part");
+        rig.render(0.01); // The panel echoes back into the edit part
+        return juce::Result::ok();
+    }
+
+    /** Seeded render of one low note with a long release; returns the left channel. */
+    std::vector<float> renderLowTail(JunoVoiceManager::RenderEngine engine, double sampleRate, float tailFloorDb, double& voiceSeconds) {
+        JunoRandom::setGlobalSeed(1); // Before prepareToPlay: both renders must match until a tail is culled
+        TestRig rig(JUNO_VOICE_POOL_SIZE, engine, sampleRate);
+        rig.processor.getVoiceManagerNC().setTailFloorDb(tailFloorDb);
+        rig.setParameter("dcoRange", 0.0f); // 16'
+        rig.setParameter("subOsc", 1.0f);   // The longest period in the mix
+        rig.setParameter("release", 0.6f);
+
+        std::vector<float> out;
+        juce::MidiBuffer noteOn, noteOff;
+        noteOn.addEvent(juce::MidiMessage::noteOn(rig.processor.midiChannel, 24, (juce::uint8)100), 0);
+        noteOff.addEvent(juce::MidiMessage::noteOff(rig.processor.midiChannel, 24), 0);
+        rig.render(0.5, noteOn, &out);
+
+        // Same length for both renders; voiceSeconds is when the voice went idle
+        const double blockSeconds = (double)kBlockSize / sampleRate;
+        voiceSeconds = 0.0;
+        for (double t = 0.5; t < 8.5; t += blockSeconds) {
+            rig.render(0.0, t == 0.5 ? noteOff : juce::MidiBuffer(), &out); // One block
+            if (voiceSeconds == 0.0 && rig.processor.getVoiceManager().getActiveVoiceCount() == 0) voiceSeconds = t + blockSeconds;
+        }
+        if (voiceSeconds == 0.0) voiceSeconds = 8.5;
+        JunoRandom::setGlobalSeed(0);
+        return out;
+    }
+
+    juce::Result runLowTail(double sampleRate) {
+        constexpr float floorDb = -40.0f; // High enough that the prediction, not the DAC, decides the cull
+        const float floorGain = juce::Decibels::decibelsToGain(floorDb);
+        for (auto engine : { JunoVoiceManager::RenderEngine::VoiceBank, JunoVoiceManager::RenderEngine::VoiceObjects }) {
+            double culledSeconds = 0.0, fullSeconds = 0.0;
+            const auto culled = renderLowTail(engine, sampleRate, floorDb, culledSeconds);
+            const auto full = renderLowTail(engine, sampleRate, -300.0f, fullSeconds); // Culling off
+
+            // Whatever culling removed must have been under the floor
+            float maxRemoved = 0.0f;
+            for (size_t n = 0; n < culled.size(); ++n)
+                maxRemoved = juce::jmax(maxRemoved, std::abs(full[n] - culled[n]));
+
+            std::cout << engineName(engine) << ": voice ends at " << juce::String(culledSeconds, 2) << " s (" << juce::String(fullSeconds, 2)
+                      << " s unculled), removed peak " << juce::String(juce::Decibels::gainToDecibels(maxRemoved), 1) << " dB" << std::endl;
+            if (maxRemoved > floorGain)
+                return juce::Result::fail(juce::String(engineName(engine)) + ": the tail was cut "
+                                          + juce::String(juce::Decibels::gainToDecibels(maxRemoved / floorGain), 1) + " dB above the floor");
+            if (culledSeconds >= fullSeconds)
+                return juce::Result::fail(juce::String(engineName(engine)) + ": the tail was never culled, the check proves nothing");
+        }
+        return juce::Result::ok();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit; // APVTS and the processor expect a MessageManager
+    juce::ArgumentList args(argc, argv);
+
+    return juce::ConsoleApplication::invokeCatchingFailures([&args] {
+        const auto testCase = args.getValueForOption("--case");
+        const double sampleRate = args.containsOption("--sr") ? args.getValueForOption("--sr").getDoubleValue() : 48000.0;
+        if (sampleRate < 8000.0) return fail("Invalid --sr");
+
+        juce::Result result = juce::Result::ok();
+        if (testCase == "polyphony") result = runPolyphony(sampleRate);
+        else if (testCase == "multitimbral") result = runMultitimbral(sampleRate);
+        else if (testCase == "low_tail") result = runLowTail(sampleRate);
+        else return fail("Unknown --case \"" + testCase + "\" (polyphony | multitimbral | low_tail)");
+
+        if (result.failed()) return fail(testCase + ": " + result.getErrorMessage());
+        std::cout << testCase << ": OK" << std::endl;
+        return 0;
+    });
+}
@@ -0,0 +1,281 @@
+// Source/Tools/JunoRenderCLI.cpp
+#include <JuceHeader.h>
+#include <iostream>
+#include "../Core/PluginProcessor.h"
+#include "../Core/PresetManager.h"
+#include "../Core/RealtimeSentinel.h"
+#include "../Core/JunoRandom.h"
+
+/**
+ * JunoRender - Offline, faster-than-realtime renderer
+ *
+ * Plays a Standard MIDI File through SimpleJuno106AudioProcessor and writes a
+ * 24-bit WAV, with no audio device involved. Prints the realtime factor
+ * (audio seconds rendered per CPU second spent inside processBlock).
+ *
+ * Golden renders: --seed fixes every random source (see JunoRandom), so a render
+ * is reproducible. --compare checks the render against a stored reference WAV
+ * and fails (exit code 3) when the peak difference exceeds --tolerance (dBFS).
+ * --compare implies --seed=1 unless a seed is given. --engine picks the voice engine
+ * (bank | objects); the references in Tests/Golden are rendered once per engine.
+ * --voices sizes the voice pool, all of which plays (default: the build pool).
+ *
+ * Usage:
+ *   JunoRender --midi=<file.mid> --out=<file.wav> [--preset=<index | file.json | file.syx>]
+ *              [--preset-index=<n>] [--sr=<hz>] [--block=<samples>] [--tail=<seconds>] [--rt-check]
+ *              [--seed=<n>] [--compare=<reference.wav>] [--tolerance=<dBFS>] [--engine=<bank | objects>]
+ *              [--voices=<1..128>]
+ */
+namespace
+{
+    struct RenderOptions {
+        juce::File midiFile, outFile;
+        juce::String preset = "0";
+        int presetIndex = 0;
+        double sampleRate = 48000.0;
+        int blockSize = 512;
+        double tailSeconds = 2.0;
+        bool rtCheck = false;
+        juce::int64 seed = 0;              // 0 = unseeded
+        juce::File referenceFile;          // Golden render to compare against
+        double toleranceDb = -80.0;        // Max allowed peak difference
+        juce::String engine;               // "bank" | "objects", empty = build default
+        int voices = 0;                    // Pool size, 0 = build default
+    };
+
+    int fail(const juce::String& message) {
+        std::cerr << "JunoRender: " << message << std::endl;
+        return 1;
+    }
+
+    void printUsage() {
+        std::cout << "Usage: JunoRender --midi=<file.mid> --out=<file.wav> [--preset=<index|file.json|file.syx>]\n"
+                     "                  [--preset-index=<n>] [--sr=<hz>] [--block=<samples>] [--tail=<seconds>] [--rt-check]\n"
+                     "                  [--seed=<n>] [--compare=<reference.wav>] [--tolerance=<dBFS>] [--engine=<bank|objects>]\n"
+                     "                  [--voices=<1..128>]\n";
+    }
+
+    juce::Result loadMidi(const juce::File& file, juce::MidiMessageSequence& out) {
+        juce::FileInputStream in(file);
+        if (!in.openedOk()) return juce::Result::fail("Cannot open " + file.getFullPathName());
+
+        juce::MidiFile midi;
+        if (!midi.readFrom(in)) return juce::Result::fail("Not a Standard MIDI File: " + file.getFullPathName());
+        midi.convertTimestampTicksToSeconds();
+
+        for (int t = 0; t < midi.getNumTracks(); ++t)
+            out.addSequence(*midi.getTrack(t), 0.0);
+        out.sort();
+        return juce::Result::ok();
+    }
+
+    float toDb(float gain) { return juce::Decibels::gainToDecibels(gain, -200.0f); }
+
+    /** Compares a render with a reference WAV; fails if the peak difference exceeds the tolerance. */
+    juce::Result compareWithReference(const juce::AudioBuffer<float>& rendered, const RenderOptions& opts) {
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatReader> reader(wav.createReaderFor(new juce::FileInputStream(opts.referenceFile), true));
+        if (reader == nullptr) return juce::Result::fail("Cannot read reference " + opts.referenceFile.getFullPathName());
+
+        if ((int)reader->numChannels != rendered.getNumChannels() || reader->sampleRate != opts.sampleRate)
+            return juce::Result::fail("Reference format differs (channels / sample rate)");
+        if (reader->lengthInSamples != (juce::int64)rendered.getNumSamples())
+            return juce::Result::fail("Reference length " + juce::String(reader->lengthInSamples)
+                                      + " != rendered length " + juce::String(rendered.getNumSamples()));
+
+        juce::AudioBuffer<float> reference(rendered.getNumChannels(), rendered.getNumSamples());
+        reader->read(&reference, 0, reference.getNumSamples(), 0, true, true);
+
+        float peakDiff = 0.0f;
+        double sumSq = 0.0;
+        juce::int64 firstMismatch = -1;
+        const float tolerance = juce::Decibels::decibelsToGain((float)opts.toleranceDb);
+
+        for (int ch = 0; ch < rendered.getNumChannels(); ++ch) {
+            const float* a = rendered.getReadPointer(ch);
+            const float* b = reference.getReadPointer(ch);
+            for (int i = 0; i < rendered.getNumSamples(); ++i) {
+                const float d = std::abs(a[i] - b[i]);
+                sumSq += (double)d * d;
+                peakDiff = juce::jmax(peakDiff, d);
+                if (d > tolerance && (firstMismatch < 0 || i < firstMismatch)) firstMismatch = i;
+            }
+        }
+
+        const float rmsDiff = (float)std::sqrt(sumSq / juce::jmax(1.0, (double)rendered.getNumChannels() * rendered.getNumSamples()));
+        std::cout << "Compare vs " << opts.referenceFile.getFileName() << ": peak diff " << juce::String(toDb(peakDiff), 1)
+                  << " dBFS, RMS diff " << juce::String(toDb(rmsDiff), 1) << " dBFS (tolerance "
+                  << juce::String(opts.toleranceDb, 1) << " dBFS)" << std::endl;
+
+        if (firstMismatch >= 0)
+            return juce::Result::fail("Render differs from reference at sample " + juce::String(firstMismatch)
+                                      + " (" + juce::String((double)firstMismatch / opts.sampleRate, 3) + " s)");
+        return juce::Result::ok();
+    }
+
+    juce::Result applyPreset(SimpleJuno106AudioProcessor& processor, const RenderOptions& opts) {
+        auto* pm = processor.getPresetManager();
+        if (pm == nullptr) return juce::Result::fail("No preset manager");
+
+        if (opts.preset.containsOnly("0123456789")) { // Factory index
+            pm->selectLibrary(0);
+            processor.loadPreset(opts.preset.getIntValue());
+            return juce::Result::ok();
+        }
+
+        juce::File file = juce::File::getCurrentWorkingDirectory().getChildFile(opts.preset);
+        if (!file.existsAsFile()) return juce::Result::fail("Preset file not found: " + opts.preset);
+
+        if (file.hasFileExtension("json")) {
+            auto r = pm->addLibraryFromJson(file);
+            if (r.failed()) return r;
+        } else if (file.hasFileExtension("syx")) {
+            juce::MemoryBlock mb;
+            if (!file.loadFileAsData(mb)) return juce::Result::fail("Read error: " + opts.preset);
+            pm->addLibraryFromSysEx((const uint8_t*)mb.getData(), (int)mb.getSize());
+            if (pm->getPresetNames().isEmpty()) return juce::Result::fail("No Juno-106 patch dumps in " + opts.preset);
+        } else {
+            return juce::Result::fail("Unsupported preset format: " + opts.preset);
+        }
+
+        processor.loadPreset(opts.presetIndex);
+        return juce::Result::ok();
+    }
+
+    int render(const RenderOptions& opts) {
+        juce::MidiMessageSequence sequence;
+        auto midiResult = loadMidi(opts.midiFile, sequence);
+        if (midiResult.failed()) return fail(midiResult.getErrorMessage());
+
+        JunoRandom::setGlobalSeed(opts.seed); // Before prepareToPlay: sources are seeded there
+
+        SimpleJuno106AudioProcessor processor(opts.voices > 0 ? opts.voices : JUNO_VOICE_POOL_SIZE);
+        if (opts.engine.isNotEmpty()) // Before prepareToPlay: voices don't migrate between engines
+            processor.getVoiceManagerNC().setRenderEngine(opts.engine == "bank" ? JunoVoiceManager::RenderEngine::VoiceBank
+                                                                                : JunoVoiceManager::RenderEngine::VoiceObjects);
+        processor.setPlayConfigDetails(0, 2, opts.sampleRate, opts.blockSize);
+        processor.setNonRealtime(true); // Offline: no CPU-budget voice shedding
+        processor.prepareToPlay(opts.sampleRate, opts.blockSize);
+
+        auto presetResult = applyPreset(processor, opts);
+        if (presetResult.failed()) return fail(presetResult.getErrorMessage());
+
+        opts.outFile.deleteFile();
+        std::unique_ptr<juce::FileOutputStream> stream(opts.outFile.createOutputStream());
+        if (stream == nullptr) return fail("Cannot write " + opts.outFile.getFullPathName());
+
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), opts.sampleRate, 2, 24, {}, 0));
+        if (writer == nullptr) return fail("Cannot create WAV writer");
+        stream.release(); // Owned by the writer now
+
+        const double endTime = sequence.getEndTime() + opts.tailSeconds;
+        const juce::int64 totalSamples = (juce::int64)std::ceil(endTime * opts.sampleRate);
+
+        juce::AudioBuffer<float> buffer(2, opts.blockSize);
+        juce::AudioBuffer<float> rendered; // Whole render, kept only for --compare
+        if (opts.referenceFile != juce::File()) rendered.setSize(2, (int)totalSamples);
+        juce::MidiBuffer midi;
+        int nextEvent = 0;
+        double cpuSeconds = 0.0;
+
+        if (opts.rtCheck) JunoRT::resetViolationCounts();
+
+        for (juce::int64 pos = 0; pos < totalSamples; pos += opts.blockSize) {
+            const int numSamples = (int)juce::jmin((juce::int64)opts.blockSize, totalSamples - pos);
+            const double blockEnd = (double)(pos + numSamples) / opts.sampleRate;
+
+            midi.clear();
+            while (nextEvent < sequence.getNumEvents()) {
+                const auto& msg = sequence.getEventPointer(nextEvent)->message;
+                if (msg.getTimeStamp() >= blockEnd) break;
+                if (!msg.isMetaEvent()) {
+                    const int offset = (int)(msg.getTimeStamp() * opts.sampleRate) - (int)pos;
+                    midi.addEvent(msg, juce::jlimit(0, numSamples - 1, offset));
+                }
+                ++nextEvent;
+            }
+
+            buffer.setSize(2, numSamples, false, false, true);
+            buffer.clear();
+
+            const double t0 = juce::Time::getMillisecondCounterHiRes();
+            processor.processBlock(buffer, midi);
+            cpuSeconds += (juce::Time::getMillisecondCounterHiRes() - t0) * 0.001;
+
+            writer->writeFromAudioSampleBuffer(buffer, 0, numSamples);
+            if (rendered.getNumSamples() > 0)
+                for (int ch = 0; ch < 2; ++ch)
+                    rendered.copyFrom(ch, (int)pos, buffer, ch, 0, numSamples);
+        }
+
+        writer.reset();
+        processor.releaseResources();
+
+        const double audioSeconds = (double)totalSamples / opts.sampleRate;
+        std::cout << "Rendered " << juce::String(audioSeconds, 2) << " s to " << opts.outFile.getFullPathName() << "\n"
+                  << "CPU time " << juce::String(cpuSeconds, 3) << " s, realtime factor "
+                  << juce::String(cpuSeconds > 0.0 ? audioSeconds / cpuSeconds : 0.0, 1) << "x" << std::endl;
+
+        if (opts.rtCheck) {
+           #if JUNO_RT_SENTINEL
+            const int violations = JunoRT::getViolationCount();
+            std::cout << "RT sentinel: " << violations << " violation(s)" << std::endl;
+            if (violations > 0) return 2;
+           #else
+            return fail("--rt-check requires a build with JUNO_RT_SENTINEL=ON");
+           #endif
+        }
+
+        if (rendered.getNumSamples() > 0) {
+            auto compareResult = compareWithReference(rendered, opts);
+            if (compareResult.failed()) {
+                std::cerr << "JunoRender: " << compareResult.getErrorMessage() << std::endl;
+                return 3;
+            }
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit; // APVTS and the processor expect a MessageManager
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h") || args.size() == 0) {
+        printUsage();
+        return args.size() == 0 ? 1 : 0;
+    }
+
+    return juce::ConsoleApplication::invokeCatchingFailures([&args] {
+        RenderOptions opts;
+        opts.midiFile = args.getExistingFileForOption("--midi");
+        opts.outFile = args.getFileForOption("--out");
+        if (args.containsOption("--preset")) opts.preset = args.getValueForOption("--preset");
+        if (args.containsOption("--preset-index")) opts.presetIndex = args.getValueForOption("--preset-index").getIntValue();
+        if (args.containsOption("--sr")) opts.sampleRate = args.getValueForOption("--sr").getDoubleValue();
+        if (args.containsOption("--block")) opts.blockSize = args.getValueForOption("--block").getIntValue();
+        if (args.containsOption("--tail")) opts.tailSeconds = args.getValueForOption("--tail").getDoubleValue();
+        opts.rtCheck = args.containsOption("--rt-check");
+        if (args.containsOption("--compare")) {
+            opts.referenceFile = args.getFileForOption("--compare");
+            opts.seed = 1; // Golden renders are always seeded
+            // [Fix] A missing reference is a failure, never a skip
+            if (!opts.referenceFile.existsAsFile())
+                return fail("Reference not found: " + opts.referenceFile.getFullPathName()
+                            + " (render it with the juno_update_golden target and check it in)");
+        }
+        if (args.containsOption("--seed")) opts.seed = args.getValueForOption("--seed").getLargeIntValue();
+        if (args.containsOption("--tolerance")) opts.toleranceDb = args.getValueForOption("--tolerance").getDoubleValue();
+
+        if (args.containsOption("--engine")) opts.engine = args.getValueForOption("--engine");
+        if (args.containsOption("--voices")) opts.voices = args.getValueForOption("--voices").getIntValue();
+
+        if (opts.sampleRate < 8000.0 || opts.blockSize < 1) return fail("Invalid --sr or --block");
+        if (args.containsOption("--voices") && !juce::isPositiveAndNotGreaterThan(opts.voices, JunoVoiceManager::kMaxPoolSize))
+            return fail("Invalid --voices (1.." + juce::String(JunoVoiceManager::kMaxPoolSize) + ")");
+        if (opts.engine.isNotEmpty() && opts.engine != "bank" && opts.engine != "objects") return fail("Invalid --engine (bank | objects)");
+        return render(opts);
+    });
+}
@@ -0,0 +1,154 @@
+// Source/Tools/JunoRtCheck.cpp
+#include <JuceHeader.h>
+#include <iostream>
+#include "../Core/PluginProcessor.h"
+#include "../Core/RealtimeSentinel.h"
+
+/**
+ * JunoRtCheck - Realtime-safety regression test (CTest: rt_check)
+ *
+ * Always built with the RT sentinel armed. Plays a scripted performance through
+ * processBlock for both render engines at several host block sizes, with UI-side
+ * keyboard notes, parameter moves and a panic issued from this (message) thread
+ * between blocks. Exits with 1 if processBlock allocated, freed or took a lock.
+ *
+ * Script: one event per line, "<seconds> <kind> <args...>", '#' starts a comment.
+ *   on <ch> <note> <vel> | off <ch> <note> | cc <ch> <cc> <value> | bend <ch> <0..16383>
+ *   pc <ch> <program> | sysex <hex bytes between F0 and F7>
+ *   ui-on <note> | ui-off <note> | param <id> <normalised 0..1> | panic
+ *
+ * Usage: JunoRtCheck --script=<file> [--sr=<hz>] [--tail=<seconds>]
+ */
+namespace
+{
+    struct ScriptEvent {
+        double time = 0.0;
+        juce::MidiMessage midi;         // Host MIDI, when uiAction is empty
+        juce::String uiAction, paramId; // ui-on / ui-off / param / panic
+        int note = 0;
+        float value = 0.0f;
+    };
+
+    int fail(const juce::String& message) {
+        std::cerr << "JunoRtCheck: " << message << std::endl;
+        return 1;
+    }
+
+    juce::Result parseScript(const juce::File& file, std::vector<ScriptEvent>& events) {
+        juce::StringArray lines;
+        lines.addLines(file.loadFileAsString());
+
+        for (int n = 0; n < lines.size(); ++n) {
+            const auto line = lines[n].upToFirstOccurrenceOf("#", false, false).trim();
+            if (line.isEmpty()) continue;
+
+            auto tokens = juce::StringArray::fromTokens(line, " \t", {});
+            tokens.removeEmptyStrings();
+            const auto where = file.getFileName() + ":" + juce::String(n + 1);
+            if (tokens.size() < 2) return juce::Result::fail(where + ": expected <seconds> <kind>");
+
+            ScriptEvent e;
+            e.time = tokens[0].getDoubleValue();
+            const auto kind = tokens[1];
+            auto arg = [&tokens](int i) { return tokens[i + 2].getIntValue(); };
+            const int numArgs = tokens.size() - 2;
+
+            if (kind == "on" && numArgs == 3)           e.midi = juce::MidiMessage::noteOn(arg(0), arg(1), (juce::uint8)arg(2));
+            else if (kind == "off" && numArgs == 2)     e.midi = juce::MidiMessage::noteOff(arg(0), arg(1));
+            else if (kind == "cc" && numArgs == 3)      e.midi = juce::MidiMessage::controllerEvent(arg(0), arg(1), arg(2));
+            else if (kind == "bend" && numArgs == 2)    e.midi = juce::MidiMessage::pitchWheel(arg(0), arg(1));
+            else if (kind == "pc" && numArgs == 2)      e.midi = juce::MidiMessage::programChange(arg(0), arg(1));
+            else if (kind == "sysex" && numArgs > 0) {
+                juce::MemoryBlock body;
+                for (int i = 2; i < tokens.size(); ++i) {
+                    const auto byte = (juce::uint8)tokens[i].getHexValue32();
+                    body.append(&byte, 1);
+                }
+                e.midi = juce::MidiMessage::createSysExMessage(body.getData(), (int)body.getSize());
+            }
+            else if ((kind == "ui-on" || kind == "ui-off") && numArgs == 1) { e.uiAction = kind; e.note = arg(0); }
+            else if (kind == "param" && numArgs == 2) { e.uiAction = kind; e.paramId = tokens[2]; e.value = tokens[3].getFloatValue(); }
+            else if (kind == "panic" && numArgs == 0)   e.uiAction = kind;
+            else return juce::Result::fail(where + ": cannot parse \"" + line + "\"");
+
+            events.push_back(e);
+        }
+
+        std::stable_sort(events.begin(), events.end(), [](const ScriptEvent& a, const ScriptEvent& b) { return a.time < b.time; });
+        return juce::Result::ok();
+    }
+
+    /** Message-thread side of the script: what the editor would do. */
+    void runUiAction(SimpleJuno106AudioProcessor& processor, const ScriptEvent& e) {
+        if (e.uiAction == "ui-on") processor.keyboardState.noteOn(processor.midiChannel, e.note, 0.8f);
+        else if (e.uiAction == "ui-off") processor.keyboardState.noteOff(processor.midiChannel, e.note, 0.0f);
+        else if (e.uiAction == "panic") processor.triggerPanic();
+        else if (auto* p = processor.getAPVTS().getParameter(e.paramId)) p->setValueNotifyingHost(e.value);
+    }
+
+    /** Plays the script once; returns the number of sentinel violations inside processBlock. */
+    int runCase(const std::vector<ScriptEvent>& events, JunoVoiceManager::RenderEngine engine,
+                double sampleRate, int blockSize, double tailSeconds) {
+        SimpleJuno106AudioProcessor processor;
+        processor.getVoiceManagerNC().setRenderEngine(engine);
+        processor.setPlayConfigDetails(0, 2, sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midi;
+        midi.ensureSize(4096); // processBlock appends MIDI out to it: preallocate, as hosts do
+        const double endTime = (events.empty() ? 0.0 : events.back().time) + tailSeconds;
+        const auto totalSamples = (juce::int64)std::ceil(endTime * sampleRate);
+        size_t next = 0;
+
+        JunoRT::resetViolationCounts();
+        for (juce::int64 pos = 0; pos < totalSamples; pos += blockSize) {
+            const double blockEnd = (double)(pos + blockSize) / sampleRate;
+
+            midi.clear();
+            for (; next < events.size() && events[next].time < blockEnd; ++next) {
+                const auto& e = events[next];
+                if (e.uiAction.isNotEmpty()) { runUiAction(processor, e); continue; }
+                const int offset = (int)(e.time * sampleRate) - (int)pos;
+                midi.addEvent(e.midi, juce::jlimit(0, blockSize - 1, offset));
+            }
+
+            buffer.clear();
+            processor.processBlock(buffer, midi);
+        }
+        const int violations = JunoRT::getViolationCount();
+
+        processor.releaseResources();
+        return violations;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit; // This thread is the message thread for the UI actions
+    juce::ArgumentList args(argc, argv);
+
+    return juce::ConsoleApplication::invokeCatchingFailures([&args] {
+        const auto scriptFile = args.getExistingFileForOption("--script");
+        const double sampleRate = args.containsOption("--sr") ? args.getValueForOption("--sr").getDoubleValue() : 48000.0;
+        const double tailSeconds = args.containsOption("--tail") ? args.getValueForOption("--tail").getDoubleValue() : 0.5;
+        if (sampleRate < 8000.0) return fail("Invalid --sr");
+
+        std::vector<ScriptEvent> events;
+        const auto parsed = parseScript(scriptFile, events);
+        if (parsed.failed()) return fail(parsed.getErrorMessage());
+
+        int total = 0;
+        for (auto engine : { JunoVoiceManager::RenderEngine::VoiceBank, JunoVoiceManager::RenderEngine::VoiceObjects }) {
+            for (int blockSize : { 32, 100, 512, 2048 }) { // Below, off and above the render chunk
+                const int violations = runCase(events, engine, sampleRate, blockSize, tailSeconds);
+                std::cout << (engine == JunoVoiceManager::RenderEngine::VoiceBank ? "VoiceBank   " : "VoiceObjects")
+                          << " block " << blockSize << ": " << violations << " violation(s)" << std::endl;
+                total += violations;
+            }
+        }
+
+        std::cout << "RT sentinel: " << total << " violation(s) in processBlock" << std::endl;
+        return total > 0 ? 1 : 0;
+    });
+}